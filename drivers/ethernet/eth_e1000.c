@@ -84,29 +84,125 @@ static enum ethernet_hw_caps e1000_caps(const struct device *dev)
 	return
 #if IS_ENABLED(CONFIG_NET_VLAN)
 		ETHERNET_HW_VLAN |
+#endif
+#if IS_ENABLED(CONFIG_ETH_E1000_TSO)
+		ETHERNET_HW_TSO |
 #endif
 		ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T |
 		ETHERNET_LINK_1000BASE_T;
 }
 
+/* Hand count descriptors from the tail on to the controller and wait
+ * until the last one is written back.
+ */
+static int e1000_tx_kick(struct e1000_dev *dev, int count)
+{
+	int last = (dev->tx_tail + count - 1) % E1000_TX_DESC_COUNT;
+
+	dev->tx_tail = (dev->tx_tail + count) % E1000_TX_DESC_COUNT;
+
+	iow32(dev, TDT, dev->tx_tail);
+
+	while (!(dev->tx[last].legacy.sta)) {
+		k_yield();
+	}
+
+	LOG_DBG("tx.sta: 0x%02hx", dev->tx[last].legacy.sta);
+
+	return (dev->tx[last].legacy.sta & TDESC_STA_DD) ? 0 : -EIO;
+}
+
 static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
 {
+	volatile struct e1000_tx *tx = &dev->tx[dev->tx_tail].legacy;
+
 	hexdump(buf, len, "%zu byte(s)", len);
 
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	tx->addr = POINTER_TO_INT(buf);
+	tx->len = len;
+	tx->cso = 0;
+	tx->cmd = TDESC_EOP | TDESC_RS;
+	tx->sta = 0;
+	tx->css = 0;
+	tx->special = 0;
 
-	iow32(dev, TDT, 1);
+	return e1000_tx_kick(dev, 1);
+}
 
-	while (!(dev->tx.sta)) {
-		k_yield();
+#if defined(CONFIG_ETH_E1000_TSO)
+/* Sum of the pseudo header without the length, which the controller
+ * adds for every segment.
+ */
+static uint16_t e1000_tso_pseudo_sum(const uint8_t *addrs, size_t len)
+{
+	uint32_t sum = IPPROTO_TCP;
+
+	for (size_t i = 0; i < len; i += 2) {
+		sum += (addrs[i] << 8) | addrs[i + 1];
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static int e1000_tx_tso(struct e1000_dev *dev, struct net_pkt *pkt,
+			size_t len)
+{
+	volatile struct e1000_tx_ctx *ctx;
+	volatile struct e1000_tx_data *data;
+	uint8_t *ip = dev->txb + sizeof(struct net_eth_hdr);
+	size_t ip_len, hdr_len;
+	bool ipv4;
+
+	if (ntohs(NET_ETH_HDR(pkt)->type) == NET_ETH_PTYPE_VLAN) {
+		ip += NET_ETH_VLAN_HDR_SIZE;
 	}
 
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
+	ipv4 = (ip[0] >> 4) == 4;
+	if (ipv4) {
+		ip_len = (ip[0] & 0x0f) * 4U;
+		/* The controller sums up the header as it is */
+		ip[10] = ip[11] = 0U;
+		sys_put_be16(e1000_tso_pseudo_sum(ip + 12, 8),
+			     ip + ip_len + 16);
+	} else {
+		ip_len = NET_IPV6H_LEN + net_pkt_ipv6_ext_len(pkt);
+		sys_put_be16(e1000_tso_pseudo_sum(ip + 8, 32),
+			     ip + ip_len + 16);
+	}
 
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
+	hdr_len = ip - dev->txb + ip_len + 4U * (ip[ip_len + 12] >> 4);
+
+	hexdump(dev->txb, hdr_len, "%zu byte(s), mss %hu", len,
+		net_pkt_gso_size(pkt));
+
+	ctx = &dev->tx[dev->tx_tail].ctx;
+	ctx->ipcss = ip - dev->txb;
+	ctx->ipcso = ctx->ipcss + 10;
+	ctx->ipcse = ctx->ipcss + ip_len - 1;
+	ctx->tucss = ctx->ipcss + ip_len;
+	ctx->tucso = ctx->tucss + 16;
+	ctx->tucse = 0;
+	ctx->paylen_cmd = (len - hdr_len) | TDESC_DEXT | TDESC_TSE |
+			  TDESC_TCP | (ipv4 ? TDESC_IP : 0);
+	ctx->sta = 0;
+	ctx->hdrlen = hdr_len;
+	ctx->mss = net_pkt_gso_size(pkt);
+
+	data = &dev->tx[(dev->tx_tail + 1) % E1000_TX_DESC_COUNT].data;
+	data->addr = POINTER_TO_INT(dev->txb);
+	data->len_cmd = len | TDESC_DTYP_DATA | TDESC_DEXT | TDESC_TSE |
+			TDESC_DCMD(TDESC_EOP | TDESC_RS);
+	data->sta = 0;
+	data->popts = TDESC_POPTS_TXSM | (ipv4 ? TDESC_POPTS_IXSM : 0);
+	data->special = 0;
+
+	return e1000_tx_kick(dev, 2);
 }
+#endif /* CONFIG_ETH_E1000_TSO */
 
 static int e1000_send(const struct device *device, struct net_pkt *pkt)
 {
@@ -117,6 +213,12 @@ static int e1000_send(const struct device *device, struct net_pkt *pkt)
 		return -EIO;
 	}
 
+#if defined(CONFIG_ETH_E1000_TSO)
+	if (net_pkt_gso_size(pkt)) {
+		return e1000_tx_tso(dev, pkt, len);
+	}
+#endif
+
 	return e1000_tx(dev, dev->txb, len);
 }
 
@@ -237,7 +339,7 @@ int e1000_probe(const struct device *device)
 
 	iow32(dev, TDBAL, (uint32_t) &dev->tx);
 	iow32(dev, TDBAH, 0);
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDLEN, sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
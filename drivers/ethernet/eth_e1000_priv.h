@@ -30,6 +30,18 @@ extern "C" {
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
 
+#define TDESC_DTYP_DATA	(1 << 20) /* TCP/IP Data Descriptor */
+#define TDESC_TCP	(1 << 24) /* Context: TCP packet */
+#define TDESC_IP	(1 << 25) /* Context: IPv4 packet */
+#define TDESC_TSE	(1 << 26) /* TCP Segmentation Enable */
+#define TDESC_DEXT	(1 << 29) /* Extension, not a legacy descriptor */
+#define TDESC_DCMD(_x)	((_x) << 24) /* Data: legacy command bits */
+
+#define TDESC_POPTS_IXSM     (1) /* Insert IP Checksum */
+#define TDESC_POPTS_TXSM (1 << 1) /* Insert TCP Checksum */
+
+#define E1000_TX_DESC_COUNT 8 /* The ring is a multiple of 128 bytes */
+
 #define ETH_ALEN 6	/* TODO: Add a global reusable definition in OS */
 
 enum e1000_reg_t {
@@ -64,6 +76,35 @@ struct e1000_tx {
 	uint16_t special;
 };
 
+/* TCP/IP Context TX Descriptor */
+struct e1000_tx_ctx {
+	uint8_t  ipcss;
+	uint8_t  ipcso;
+	uint16_t ipcse;
+	uint8_t  tucss;
+	uint8_t  tucso;
+	uint16_t tucse;
+	uint32_t paylen_cmd;	/* Payload length, type and command */
+	uint8_t  sta;
+	uint8_t  hdrlen;
+	uint16_t mss;
+};
+
+/* TCP/IP Data TX Descriptor */
+struct e1000_tx_data {
+	uint64_t addr;
+	uint32_t len_cmd;	/* Length, type and command */
+	uint8_t  sta;
+	uint8_t  popts;
+	uint16_t special;
+};
+
+union e1000_tx_desc {
+	struct e1000_tx legacy;
+	struct e1000_tx_ctx ctx;
+	struct e1000_tx_data data;
+};
+
 /* Legacy RX Descriptor */
 struct e1000_rx {
 	uint64_t addr;
@@ -74,8 +115,16 @@ struct e1000_rx {
 	uint16_t special;
 };
 
+#if defined(CONFIG_ETH_E1000_TSO)
+#define E1000_TXB_SIZE	(NET_ETH_MAX_FRAME_SIZE + \
+			 NET_ETH_VLAN_HDR_SIZE + CONFIG_NET_TCP_GSO_MAX_SIZE)
+#else
+#define E1000_TXB_SIZE	NET_ETH_MTU
+#endif
+
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
+	volatile union e1000_tx_desc tx[E1000_TX_DESC_COUNT] __aligned(16);
+	int tx_tail;
 	volatile struct e1000_rx rx __aligned(16);
 	mm_reg_t address;
 	/* If VLAN is enabled, there can be multiple VLAN interfaces related to
@@ -84,7 +133,7 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
+	uint8_t txb[E1000_TXB_SIZE];
 	uint8_t rxb[NET_ETH_MTU];
 };
 
@@ -23,11 +23,21 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_if.h>
 
 #include <net/dummy.h>
+#include <net/loopback.h>
+#include <random/rand32.h>
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY)
+static void loopback_delay_init(void);
+#else
+#define loopback_delay_init(...)
+#endif
 
 int loopback_dev_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
 
+	loopback_delay_init();
+
 	return 0;
 }
 
@@ -38,6 +48,127 @@ static void loopback_init(struct net_if *iface)
 			     NET_LINK_DUMMY);
 }
 
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+static uint32_t drop_threshold;
+static uint32_t dropped;
+
+int loopback_set_packet_drop_ratio(float ratio)
+{
+	if (ratio < 0.0f || ratio > 1.0f) {
+		return -EINVAL;
+	}
+
+	drop_threshold = (uint32_t)(ratio * (double)UINT32_MAX);
+
+	return 0;
+}
+
+uint32_t loopback_get_num_dropped_packets(void)
+{
+	return dropped;
+}
+
+static bool loopback_drop(void)
+{
+	if (drop_threshold == 0U || sys_rand32_get() > drop_threshold) {
+		return false;
+	}
+
+	dropped++;
+
+	return true;
+}
+#else
+static inline bool loopback_drop(void)
+{
+	return false;
+}
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY)
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	uint32_t due;
+};
+
+K_MSGQ_DEFINE(delay_queue, sizeof(struct loopback_delayed_pkt),
+	      CONFIG_NET_PKT_RX_COUNT, 4);
+static struct k_delayed_work delay_work;
+static uint32_t delay_ms;
+
+int loopback_set_packet_delay(uint32_t ms)
+{
+	delay_ms = ms;
+
+	return 0;
+}
+
+/* Receive the packets that are due, then wait for the next one */
+static void loopback_delay_expired(struct k_work *work)
+{
+	struct loopback_delayed_pkt entry;
+	int32_t left;
+
+	ARG_UNUSED(work);
+
+	while (k_msgq_peek(&delay_queue, &entry) == 0) {
+		left = (int32_t)(entry.due - k_uptime_get_32());
+		if (left > 0) {
+			k_delayed_work_submit(&delay_work, K_MSEC(left));
+			break;
+		}
+
+		(void)k_msgq_get(&delay_queue, &entry, K_NO_WAIT);
+
+		if (net_recv_data(net_pkt_iface(entry.pkt), entry.pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(entry.pkt);
+		}
+	}
+}
+
+static void loopback_delay_init(void)
+{
+	k_delayed_work_init(&delay_work, loopback_delay_expired);
+}
+
+/* Returns true if the packet is received later */
+static bool loopback_delay(struct net_pkt *pkt)
+{
+	struct loopback_delayed_pkt entry = {
+		.pkt = pkt,
+		.due = k_uptime_get_32() + delay_ms,
+	};
+	bool first;
+
+	if (delay_ms == 0U) {
+		return false;
+	}
+
+	/* The work must not empty the queue between the check and the put */
+	k_sched_lock();
+
+	first = k_msgq_num_used_get(&delay_queue) == 0U;
+
+	if (k_msgq_put(&delay_queue, &entry, K_NO_WAIT) < 0) {
+		LOG_DBG("Delay queue full, dropping %p", pkt);
+		net_pkt_unref(pkt);
+	} else if (first) {
+		/* Otherwise the work waits for an earlier packet already */
+		k_delayed_work_submit(&delay_work, K_MSEC(delay_ms));
+	}
+
+	k_sched_unlock();
+
+	return true;
+}
+#else
+static inline bool loopback_delay(struct net_pkt *pkt)
+{
+	return false;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -50,6 +181,13 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		return -ENODATA;
 	}
 
+	/* A dropped packet is sent successfully as far as the sender can
+	 * tell
+	 */
+	if (loopback_drop()) {
+		return 0;
+	}
+
 	/* We need to swap the IP addresses because otherwise
 	 * the packet will be dropped.
 	 */
@@ -81,6 +219,11 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (loopback_delay(cloned)) {
+		res = 0;
+		goto out;
+	}
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
@@ -43,6 +43,11 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Addresses of the most recent allocation table entries,
+ * indexed by hashed id (only with CONFIG_NVS_LOOKUP_CACHE)
+ * @param gc_work Background garbage collection work item, gc_bg_addr and
+ * gc_bg_stop its position in the sector it empties, gc_bg_done set when that
+ * sector has been erased (only with CONFIG_NVS_BACKGROUND_GC)
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +62,15 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	struct k_work gc_work;
+	uint32_t gc_bg_addr;
+	uint32_t gc_bg_stop;
+	bool gc_bg_done;
+#endif
 };
 
 /**
@@ -85,7 +99,8 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name);
 /**
  * @brief nvs_clear
  *
- * Clears the NVS file system from flash.
+ * Clears the NVS file system from flash. The file system has to be
+ * initialized again with nvs_init() before it is used.
  * @param fs Pointer to file system
  * @retval 0 Success
  * @retval -ERRNO errno code if error
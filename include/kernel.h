@@ -203,6 +203,11 @@ struct _thread_base {
 
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds this thread while it is queued */
+	uint8_t runq_cpu;
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 	/* "May run on" bits for each CPU */
 	uint8_t cpu_mask;
@@ -2469,6 +2474,108 @@ struct k_fifo {
 
 /** @} */
 
+struct k_fifo_mpsc {
+	struct mpsc queue;
+	atomic_t pending;
+	_wait_q_t wait_q;
+	struct k_spinlock lock;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_FIFO_MPSC_INITIALIZER(obj) \
+	{ \
+	.queue = MPSC_INIT((obj).queue), \
+	.pending = ATOMIC_INIT(0), \
+	.wait_q = Z_WAIT_Q_INIT(&(obj).wait_q), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup fifo_mpsc_apis Lock-free FIFO APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a lock-free FIFO.
+ *
+ * A lock-free FIFO is a k_fifo variant for the common case of many
+ * producers (threads on any CPU as well as ISRs) feeding a single
+ * consumer thread.  Items are linked into a lock-free MPSC queue, so
+ * putting an item neither takes a lock nor enters the scheduler,
+ * unless the consumer is actually pended waiting for data.
+ *
+ * Unlike k_fifo, only one thread may get items from a lock-free
+ * FIFO, it is not a user mode kernel object and it cannot be
+ * k_poll()ed.
+ *
+ * @param fifo Address of the FIFO.
+ *
+ * @return N/A
+ */
+void k_fifo_mpsc_init(struct k_fifo_mpsc *fifo);
+
+/**
+ * @brief Add an element to a lock-free FIFO.
+ *
+ * The first word of the item is reserved for the kernel's use, as
+ * with k_fifo_put().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param fifo Address of the FIFO.
+ * @param data Address of the data item.
+ *
+ * @return N/A
+ */
+void k_fifo_mpsc_put(struct k_fifo_mpsc *fifo, void *data);
+
+/**
+ * @brief Get an element from a lock-free FIFO.
+ *
+ * Must only ever be called by the FIFO's single consumer thread.
+ *
+ * @param fifo Address of the FIFO.
+ * @param timeout Waiting period to obtain a data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the data item if successful; NULL if returned
+ * without waiting, or waiting period timed out.
+ */
+void *k_fifo_mpsc_get(struct k_fifo_mpsc *fifo, k_timeout_t timeout);
+
+/**
+ * @brief Query a lock-free FIFO to see if it has data available.
+ *
+ * @param fifo Address of the FIFO.
+ *
+ * @return Non-zero if the FIFO is empty.
+ * @return 0 if data is available.
+ */
+static inline int k_fifo_mpsc_is_empty(struct k_fifo_mpsc *fifo)
+{
+	return (int)mpsc_is_empty(&fifo->queue);
+}
+
+/**
+ * @brief Statically define and initialize a lock-free FIFO.
+ *
+ * The FIFO can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_fifo_mpsc <name>; @endcode
+ *
+ * @param name Name of the FIFO.
+ */
+#define K_FIFO_MPSC_DEFINE(name) \
+	struct k_fifo_mpsc name = Z_FIFO_MPSC_INITIALIZER(name)
+
+/** @} */
+
 struct k_lifo {
 	struct k_queue _queue;
 };
@@ -3538,6 +3645,151 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	uint32_t events;
+	struct k_spinlock lock;
+	_POLL_EVENT;
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	.lock = {}, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object, prior to its first use.
+ * All of its 32 events are initially clear.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Set events in an event object.
+ *
+ * This routine sets the events given by the mask @a events in @a event
+ * and wakes up every waiting thread whose wait is now satisfied, in
+ * priority order.  A woken thread that asked for its events to be
+ * cleared consumes them before the next waiter is checked.  If any
+ * events remain set, all threads polling @a event are notified.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to set.
+ *
+ * @return N/A
+ */
+__syscall void k_event_set(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Clear events in an event object.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to clear.
+ *
+ * @return N/A
+ */
+__syscall void k_event_clear(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Wait for any of the given events.
+ *
+ * This routine waits until at least one of the events given by the mask
+ * @a events is set in @a event.
+ *
+ * To wait for an event object together with other kernel objects, poll
+ * it with K_POLL_TYPE_EVENTS, which becomes ready with state
+ * K_POLL_STATE_EVENTS as soon as any event is set, then collect the
+ * events of interest with this routine and K_NO_WAIT.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for, must not be 0.
+ * @param clear Clear the matching events when returning them.
+ * @param timeout Waiting period for the events, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return The subset of @a events that was set, or 0 if the waiting
+ *         period timed out.
+ */
+__syscall uint32_t k_event_wait(struct k_event *event, uint32_t events,
+				bool clear, k_timeout_t timeout);
+
+/**
+ * @brief Wait for all of the given events.
+ *
+ * This routine waits until all of the events given by the mask @a events
+ * are set in @a event at the same time.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for, must not be 0.
+ * @param clear Clear the events when returning them.
+ * @param timeout Waiting period for the events, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return @a events, or 0 if the waiting period timed out.
+ */
+__syscall uint32_t k_event_wait_all(struct k_event *event, uint32_t events,
+				    bool clear, k_timeout_t timeout);
+
+/**
+ * @brief Get the events currently set in an event object.
+ *
+ * @param event Address of the event object.
+ *
+ * @return Set of events currently set.
+ */
+__syscall uint32_t k_event_get(struct k_event *event);
+
+static inline uint32_t z_impl_k_event_get(struct k_event *event)
+{
+	return event->events;
+}
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE(k_event, name) = \
+		Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3566,6 +3818,14 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+	/** Slot claimed by k_msgq_put_claim(), if any */
+	char *put_claim;
+	/** Message claimed by k_msgq_get_claim(), if any */
+	char *get_claim;
+	/** Thread that claimed get_claim, NULL for an ISR */
+	struct k_thread *get_claim_owner;
+	/** Threads waiting for a claim to end or a claim to succeed */
+	_wait_q_t claim_wait_q;
 
 	_OBJECT_TRACING_NEXT_PTR(k_msgq)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -3588,6 +3848,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	.claim_wait_q = Z_WAIT_Q_INIT(&obj.claim_wait_q), \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -3711,10 +3972,82 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  *
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EBUSY Returned without waiting while a slot was claimed.
  * @retval -EAGAIN Waiting period timed out.
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
+/**
+ * @brief Claim a message queue slot to build a message in place.
+ *
+ * This routine reserves the next free slot of message queue @a msgq
+ * and returns its address, so that the caller can fill in the message
+ * directly instead of having it copied by k_msgq_put().  The message
+ * is sent by k_msgq_put_commit().
+ *
+ * Only one slot can be claimed at a time.  While it is, other senders
+ * wait (or fail with -EBUSY if not allowed to) until the claim is
+ * committed, so messages stay in order.  A thread blocked in
+ * k_msgq_get() on an empty queue receives the committed message by
+ * copy as usual.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ * @note Not available to user mode threads, which cannot access the
+ * message queue's ring buffer.
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Set to the address of the claimed slot of msg_size bytes.
+ * @param timeout Waiting period to claim a slot, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Slot claimed.
+ * @retval -ENOMSG Returned without waiting, queue is full.
+ * @retval -EBUSY Returned without waiting while a slot was claimed.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_msgq_put_claim(struct k_msgq *msgq, void **slot, k_timeout_t timeout);
+
+/**
+ * @brief Send the message built in a claimed slot.
+ *
+ * This routine ends the claim taken by k_msgq_put_claim() and makes
+ * the message visible to receivers.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @return N/A
+ */
+void k_msgq_put_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a msgq, as many as fit, with a single lock
+ * acquisition and at most one reschedule.  Messages are handed to
+ * waiting receivers first and the rest are copied into the ring buffer
+ * in at most two runs.
+ *
+ * The routine only waits if not even one message can be sent, and
+ * then returns as soon as one is.  Callers with more messages to send
+ * call it again with the remainder.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages in @a data.
+ * @param timeout Waiting period to send the first message, or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent (0 only if @a num_msgs is 0) or one
+ *         of the negative error codes of k_msgq_put().
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -3731,10 +4064,82 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  *
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
+ * @retval -EBUSY Returned without waiting while a message was claimed.
  * @retval -EAGAIN Waiting period timed out.
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Claim the oldest message of a message queue to read it in place.
+ *
+ * This routine returns the address of the oldest message in message
+ * queue @a msgq without copying it out.  The message keeps occupying
+ * its slot until it is released with k_msgq_get_release().
+ *
+ * Only one message can be claimed at a time.  While it is, other
+ * receivers wait (or fail with -EBUSY if not allowed to) until it is
+ * released.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ * @note Not available to user mode threads, which cannot access the
+ * message queue's ring buffer.
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Set to the address of the claimed message.
+ * @param timeout Waiting period to claim a message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting, queue is empty.
+ * @retval -EBUSY Returned without waiting while a message was claimed.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_msgq_get_claim(struct k_msgq *msgq, void **slot, k_timeout_t timeout);
+
+/**
+ * @brief Release a claimed message.
+ *
+ * This routine removes the message claimed by k_msgq_get_claim() from
+ * the queue, freeing its slot for senders.  It must be called by the
+ * thread that claimed the message, or by an ISR if an ISR claimed it.
+ * Does nothing if the queue was purged since the message was claimed,
+ * even when another thread has claimed a message since.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @return N/A
+ */
+void k_msgq_get_release(struct k_msgq *msgq);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq into consecutive slots of @a data in "first in, first out"
+ * order, as many as are available, with a single lock acquisition and
+ * at most one reschedule.  Slots freed in the ring buffer are refilled
+ * from waiting senders before returning.
+ *
+ * The routine only waits if the queue is empty, and then returns as
+ * soon as one message is received.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an array of @a num_msgs messages to hold the
+ *             received messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message, or one
+ *                of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages received (0 only if @a num_msgs is 0) or
+ *         one of the negative error codes of k_msgq_get().
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -3755,8 +4160,9 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  * @brief Purge a message queue.
  *
  * This routine discards all unreceived messages in a message queue's ring
- * buffer. Any threads that are blocked waiting to send a message to the
- * message queue are unblocked and see an -ENOMSG error code.
+ * buffer, including a message claimed with k_msgq_get_claim(). Any threads
+ * that are blocked waiting to send a message to the message queue are
+ * unblocked and see an -ENOMSG error code.
  *
  * @param msgq Address of the message queue.
  *
@@ -4173,6 +4579,73 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/** Pipe I/O vector segment, see k_pipe_put_vec() and k_pipe_get_vec() */
+struct k_pipe_vec {
+	void *data;	/**< Address of the segment */
+	size_t bytes;	/**< Size of the segment (in bytes) */
+};
+
+/**
+ * @brief Write several segments of data to a pipe.
+ *
+ * This routine writes the segments described by @a vec to @a pipe in
+ * order, each one either whole or not at all, and stops at the first
+ * segment that does not fit.  While no reader is waiting, the
+ * segments are copied into the ring buffer under a single lock
+ * acquisition; otherwise they are handed to the waiting readers with
+ * the scheduler locked, so that readers run only once all segments
+ * have been written.
+ *
+ * The routine only waits if not even the first segment fits, and then
+ * returns once it has been written.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param vec Array of segments to write.
+ * @param vec_count Number of segments in @a vec.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param timeout Waiting period to write the first segment, or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of segments written, or one of the negative error
+ *         codes of k_pipe_put().  On timeout part of the first segment
+ *         may have been written, as reported in @a bytes_written.
+ */
+int k_pipe_put_vec(struct k_pipe *pipe, const struct k_pipe_vec *vec,
+		   size_t vec_count, size_t *bytes_written,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into several segments.
+ *
+ * This routine fills the segments described by @a vec with data read
+ * from @a pipe in order, each one either completely or not at all,
+ * and stops at the first segment that cannot be filled.  While no
+ * writer is waiting, the data is copied out of the ring buffer under
+ * a single lock acquisition; otherwise it is taken from the waiting
+ * writers with the scheduler locked, so that writers run only once all
+ * segments have been filled.
+ *
+ * The routine only waits if not even the first segment can be filled,
+ * and then returns once it has been.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param vec Array of segments to fill.
+ * @param vec_count Number of segments in @a vec.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param timeout Waiting period to fill the first segment, or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of segments filled, or one of the negative error
+ *         codes of k_pipe_get().  On timeout part of the first segment
+ *         may have been filled, as reported in @a bytes_read.
+ */
+int k_pipe_get_vec(struct k_pipe *pipe, const struct k_pipe_vec *vec,
+		   size_t vec_count, size_t *bytes_read, k_timeout_t timeout);
+
 /**
  * @brief Write memory block to a pipe.
  *
@@ -4375,10 +4848,54 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_K_HEAP_CACHE
+/* Free blocks of one size class, linked through their first word */
+struct z_heap_magazine {
+	void *head;
+	uint8_t count;
+};
+
+/* Per-CPU front end cache of a k_heap, drained by any CPU under lock */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	struct z_heap_magazine mag[CONFIG_K_HEAP_CACHE_CLASSES];
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t cached_frees;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_CACHE
+	struct z_heap_cache cache[CONFIG_MP_NUM_CPUS];
+	atomic_t cache_waiters;
+#endif
+};
+
+/**
+ * @brief k_heap usage and cache statistics
+ *
+ * Filled in by k_heap_stats_get().  The cache counters are only
+ * non-zero with CONFIG_K_HEAP_CACHE.
+ */
+struct k_heap_stats {
+	/** Free bytes in the heap, excluding cached blocks */
+	size_t free_bytes;
+	/** Allocated bytes in the heap, including cached blocks */
+	size_t allocated_bytes;
+	/** Size of the largest free block, to gauge fragmentation */
+	size_t largest_free_bytes;
+	/** Bytes held in per-CPU caches */
+	size_t cached_bytes;
+	/** Allocations served from a per-CPU cache */
+	uint32_t cache_hits;
+	/** Cacheable allocations that had to go to the heap */
+	uint32_t cache_misses;
+	/** Frees kept in a per-CPU cache instead of the heap */
+	uint32_t cached_frees;
 };
 
 /**
@@ -4427,6 +4944,44 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+/**
+ * @brief Resize memory allocated by k_heap_alloc()
+ *
+ * Resizes the specified memory block, which must have been returned
+ * from k_heap_alloc(), preserving its contents up to the smaller of
+ * the old and new sizes.  The block is shrunk or grown in place when
+ * possible (see sys_heap_realloc()) and only moved otherwise.  If no
+ * memory is available immediately, the call will block for the
+ * specified timeout waiting for memory to be freed.  On failure NULL
+ * is returned and the original block remains valid.
+ *
+ * A NULL @a ptr behaves like k_heap_alloc() and a zero @a bytes like
+ * k_heap_free().
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param h Heap from which the block was allocated
+ * @param ptr A valid memory block, or NULL
+ * @param bytes Desired new size of the block
+ * @param timeout How long to wait, or K_NO_WAIT
+ * @return A pointer to valid heap memory, or NULL
+ */
+void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Get usage statistics of a k_heap
+ *
+ * Walks the heap to report free and allocated bytes and the largest
+ * free block, along with the per-CPU cache counters summed over all
+ * CPUs when CONFIG_K_HEAP_CACHE is enabled.  Takes time linear in
+ * the number of heap chunks and is meant for diagnostics.
+ *
+ * @param h Heap to inspect
+ * @param stats Struct into which to store the statistics
+ */
+void k_heap_stats_get(struct k_heap *h, struct k_heap_stats *stats);
+
 /**
  * @brief Define a static k_heap
  *
@@ -4607,6 +5162,9 @@ enum _poll_types_bits {
 	/* queue/FIFO/LIFO data availability */
 	_POLL_TYPE_DATA_AVAILABLE,
 
+	/* event object events set */
+	_POLL_TYPE_EVENTS,
+
 	_POLL_NUM_TYPES
 };
 
@@ -4629,6 +5187,9 @@ enum _poll_states_bits {
 	/* queue/FIFO/LIFO wait was cancelled */
 	_POLL_STATE_CANCELLED,
 
+	/* events are set in an event object */
+	_POLL_STATE_EVENTS,
+
 	_POLL_NUM_STATES
 };
 
@@ -4659,6 +5220,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_SEM_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_SEM_AVAILABLE)
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
+#define K_POLL_TYPE_EVENTS Z_POLL_TYPE_BIT(_POLL_TYPE_EVENTS)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -4675,6 +5237,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
+#define K_POLL_STATE_EVENTS Z_POLL_STATE_BIT(_POLL_STATE_EVENTS)
 
 /* public - poll signal object */
 struct k_poll_signal {
@@ -4730,6 +5293,7 @@ struct k_poll_event {
 		struct k_sem *sem;
 		struct k_fifo *fifo;
 		struct k_queue *queue;
+		struct k_event *event;
 	};
 };
 
@@ -4883,6 +5447,89 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set keeps its events registered with the polled objects across
+ * waits, so waiting on it does not cost anything per idle event.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct _poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_spinlock lock;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t returned;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event is registered with its object right away and stays registered
+ * until it is removed from the set again, so it must not be passed to
+ * k_poll() or added to another set in the meantime.
+ *
+ * @param set Poll set.
+ * @param event Event initialized with k_poll_event_init().
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set,
+			   struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Poll set.
+ * @param event Event previously added to @a set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to occur
+ *
+ * Unlike k_poll(), this routine does not walk over all the events being
+ * polled: only events that occurred since the previous call are looked at
+ * and returned in @a ready, with their state field set.  The events
+ * returned by the previous call are checked again first, so an object
+ * that is still available keeps being reported, like with k_poll().
+ *
+ * A poll set can only be waited on by one thread at a time, and only
+ * from kernel mode.
+ *
+ * @param set Poll set.
+ * @param ready Array receiving the events that occurred.
+ * @param max_ready Size of @a ready, must be at least 1.
+ * @param timeout Waiting period for an event to occur,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, or -EAGAIN if the waiting
+ *         period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max_ready,
+			   k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -24,6 +24,7 @@
 #include <sys/dlist.h>
 #include <sys/slist.h>
 #include <sys/sflist.h>
+#include <sys/mpsc_lockfree.h>
 #include <sys/util.h>
 #include <sys/mempool_base.h>
 #include <kernel_structs.h>
@@ -130,6 +130,19 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload: a packet with a non-zero
+	 * net_pkt_gso_size() is split into TCP segments carrying that much
+	 * payload, and the IPv4 header and TCP checksums of every segment
+	 * are filled in.  The TCP checksum is not calculated by the stack.
+	 */
+	ETHERNET_HW_TSO			= BIT(15),
+
+	/** Large receive offload: consecutive TCP segments of a connection
+	 * may be passed to the stack as one packet larger than the MTU, with
+	 * its IP length and checksums updated.
+	 */
+	ETHERNET_HW_LRO			= BIT(16),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Network loopback interface
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+#define ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+/**
+ * @brief Make the loopback interface drop packets
+ *
+ * Packets sent through the loopback interface are dropped at random,
+ * each one with the given probability.
+ *
+ * @param ratio Share of packets to drop, from 0 (none) to 1 (all).
+ *
+ * @return 0 on success, -EINVAL if @a ratio is out of range.
+ */
+int loopback_set_packet_drop_ratio(float ratio);
+
+/**
+ * @brief Get the number of packets dropped by the loopback interface
+ *
+ * @return Number of packets dropped so far.
+ */
+uint32_t loopback_get_num_dropped_packets(void);
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY)
+/**
+ * @brief Make the loopback interface delay packets
+ *
+ * Packets sent through the loopback interface are received after the
+ * given time, in the order they were sent. At most
+ * CONFIG_NET_PKT_RX_COUNT packets can be on their way, the ones sent
+ * beyond that are dropped.
+ *
+ * @param ms One-way delay in milliseconds, 0 disables the delay.
+ *
+ * @return 0 on success.
+ */
+int loopback_set_packet_delay(uint32_t ms);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_LOOPBACK_H_ */
@@ -298,6 +298,18 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TXTIME)
 		bool txtime;
 #endif
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+		/** Receive buffer size, 0 selects the stack default */
+		int rcvbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		/** Send buffer size, 0 means no limit */
+		int sndbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
+		/** Pass the packet information to recvmsg() */
+		bool recv_pktinfo;
+#endif
 #if defined(CONFIG_SOCKS)
 		struct {
 			struct sockaddr addr;
@@ -1043,6 +1055,9 @@ enum net_context_option {
 	NET_OPT_TIMESTAMP	= 2,
 	NET_OPT_TXTIME		= 3,
 	NET_OPT_SOCKS5		= 4,
+	NET_OPT_RCVBUF		= 5,
+	NET_OPT_SNDBUF		= 6,
+	NET_OPT_RECV_PKTINFO	= 7,
 };
 
 /**
@@ -234,6 +234,12 @@ struct msghdr {
 	int           msg_flags;      /* flags on received message */
 };
 
+/** Message of sendmmsg() and recvmmsg() */
+struct mmsghdr {
+	struct msghdr msg_hdr;        /* message header */
+	unsigned int  msg_len;        /* number of bytes transmitted */
+};
+
 struct cmsghdr {
 	socklen_t cmsg_len;    /* Number of bytes, including header */
 	int       cmsg_level;  /* Originating protocol */
@@ -280,6 +286,19 @@ struct cmsghdr {
 #define CMSG_LEN(length) (ALIGN_D(sizeof(struct cmsghdr)) + length)
 #endif
 
+/** Ancillary data of IP_PKTINFO */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /* Interface index */
+	struct in_addr ipi_spec_dst; /* Local address */
+	struct in_addr ipi_addr;     /* Header destination address */
+};
+
+/** Ancillary data of IPV6_PKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* Destination address */
+	unsigned int    ipi6_ifindex; /* Interface index */
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 /* Packet types.  */
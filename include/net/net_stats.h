@@ -188,6 +188,17 @@ struct net_stats_ipv6_nd {
 	net_stats_t sent;
 };
 
+/**
+ * @brief Neighbor cache statistics
+ */
+struct net_stats_nbr {
+	/** Number of lookups that found the link layer address */
+	net_stats_t hit;
+
+	/** Number of lookups that needed address resolution */
+	net_stats_t miss;
+};
+
 /**
  * @brief IPv6 multicast listener daemon statistics
  */
@@ -303,6 +314,16 @@ struct net_stats {
 	struct net_stats_ipv6_nd ipv6_nd;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_NBR)
+	/** IPv6 neighbor cache statistics */
+	struct net_stats_nbr ipv6_nbr;
+#endif
+
+#if defined(CONFIG_NET_STATISTICS_ARP)
+	/** ARP cache statistics */
+	struct net_stats_nbr arp;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	/** IPv6 MLD statistics */
 	struct net_stats_ipv6_mld ipv6_mld;
@@ -54,8 +54,14 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Ancillary data was truncated (output value only) */
+#define ZSOCK_MSG_CTRUNC 0x08
+/** zsock_recvmsg: Datagram was truncated (output value only) */
+#define ZSOCK_MSG_TRUNC 0x20
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
+/** zsock_recvmmsg: Do not block after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -357,6 +363,22 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send several messages in one call
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for normative description. The number of bytes sent is stored in the
+ * msg_len field of each message.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -373,6 +395,38 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description. The ancillary data can hold the packet
+ * information, see ``IP_PKTINFO`` and ``IPV6_RECVPKTINFO``, and the
+ * receive timestamp, see ``SO_TIMESTAMPING``.
+ * This function is also exposed as ``recvmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Receive several messages in one call
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for normative description. Unlike Linux, there is no timeout argument,
+ * use ``MSG_WAITFORONE`` or ``MSG_DONTWAIT`` instead.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -391,6 +445,55 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/** Data lent by zsock_recv_zerocopy() */
+struct zsock_zerocopy {
+	/** Views of the received data, provided by the caller */
+	struct iovec *iov;
+	/** Number of entries in iov, set to the number of views filled in */
+	size_t iovlen;
+	/** @cond INTERNAL_HIDDEN */
+	void *pkt;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * @rst
+ * Works like ``recv()``, but instead of copying the data into a buffer,
+ * the network buffers holding it are lent to the caller: ``zc->iov`` is
+ * filled in with read-only views of them, one per buffer fragment.
+ * The buffers stay allocated until returned with
+ * :c:func:`zsock_recv_zerocopy_release`, which must be called once for
+ * every successful call.
+ *
+ * For a datagram socket, one datagram is returned, and what does not fit
+ * into ``zc->iovlen`` fragments is discarded.  For a stream socket, the
+ * rest is kept for the next call.  ``MSG_PEEK`` is not supported.
+ *
+ * Only native TCP and UDP sockets are supported, and the function is not
+ * available to user mode threads, as the buffers belong to the kernel.
+ * Available if :option:`CONFIG_NET_SOCKETS_RECV_ZEROCOPY` is enabled.
+ * @endrst
+ *
+ * @param sock Socket to receive from
+ * @param zc Views to fill in
+ * @param flags ``MSG_DONTWAIT`` or 0
+ *
+ * @return Number of bytes lent, 0 at the end of a stream, -1 on error
+ *         with errno set
+ */
+ssize_t zsock_recv_zerocopy(int sock, struct zsock_zerocopy *zc, int flags);
+
+/**
+ * @brief Return the buffers lent by zsock_recv_zerocopy()
+ *
+ * @param zc Views filled in by zsock_recv_zerocopy(), they are not valid
+ *        afterwards
+ */
+void zsock_recv_zerocopy_release(struct zsock_zerocopy *zc);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -691,12 +794,29 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -770,7 +890,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define POLLNVAL ZSOCK_POLLNVAL
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -794,10 +917,18 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define SO_REUSEADDR 2
 /** sockopt: Async error (ignored, for compatibility) */
 #define SO_ERROR 4
+/** sockopt: Size of the send buffer */
+#define SO_SNDBUF 7
+/** sockopt: Size of the receive buffer */
+#define SO_RCVBUF 8
 
-/** sockopt: Timestamp TX packets */
+/** sockopt: Timestamp TX packets, pass the RX timestamp to recvmsg() */
 #define SO_TIMESTAMPING 37
 
+/* Socket options for IPPROTO_IP level */
+/** sockopt: Pass an in_pktinfo with the received packets */
+#define IP_PKTINFO 8
+
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
@@ -805,6 +936,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
+/** sockopt: Pass an in6_pktinfo with the received packets */
+#define IPV6_RECVPKTINFO 49
+/** Ancillary data type of the in6_pktinfo */
+#define IPV6_PKTINFO 50
 
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
@@ -60,4 +60,26 @@ void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Two-level bitmap multi-queue.  Same one-list-per-priority layout
+ * as _priq_mq, but spanning every configurable priority (up to 256),
+ * with a summary word flagging the non-empty bitmap words so that
+ * the best priority is two find-first-set operations away.
+ */
+/* K_HIGHEST_THREAD_PRIO to K_LOWEST_THREAD_PRIO, the idle priority */
+#define Z_PRIQ_BM_PRIOS (CONFIG_NUM_COOP_PRIORITIES + \
+			 CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_BM_WORDS ceiling_fraction(Z_PRIQ_BM_PRIOS, 32)
+
+struct _priq_bm {
+	sys_dlist_t queues[Z_PRIQ_BM_PRIOS];
+	/* bit i % 32 of word i / 32 set if queues[i] is non-empty */
+	uint32_t bitmap[Z_PRIQ_BM_WORDS];
+	/* bit w set if bitmap[w] is non-zero */
+	uint32_t summary;
+};
+
+void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread);
+void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread);
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
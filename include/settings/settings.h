@@ -333,6 +333,40 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Start a batch of changes.
+ *
+ * Until @ref settings_batch_commit or @ref settings_batch_abort is called,
+ * @ref settings_save_one and @ref settings_delete called from the same thread
+ * only queue the change in RAM, in place of any change of the same name
+ * queued before. Other threads using the settings wait for the end of the
+ * batch.
+ *
+ * Requires CONFIG_SETTINGS_BATCH.
+ *
+ * @return 0 on success, -EBUSY if a batch is already open, -ENOENT if there is
+ * no storage back-end.
+ */
+int settings_batch_begin(void);
+
+/**
+ * Write the changes of a batch and end it.
+ *
+ * The changes are stored as a single journal entry first and then applied
+ * one by one. If the commit is interrupted by a reset after the journal was
+ * stored, @ref settings_subsys_init applies the changes again, so either all
+ * of them or none end up in the storage.
+ *
+ * @return 0 on success, -EINVAL if no batch is open, other negative error
+ * code if the back-end failed.
+ */
+int settings_batch_commit(void);
+
+/**
+ * Drop the changes of a batch and end it.
+ */
+void settings_batch_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
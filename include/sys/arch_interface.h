@@ -845,6 +845,31 @@ size_t arch_cache_line_size_get(void);
 #endif
 /** @} */
 
+/**
+ * @defgroup arch-net Architecture-specific network functions
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_ARCH_HAS_NET_CHKSUM
+/**
+ * @brief Add up a buffer for the Internet checksum
+ *
+ * Required when ARCH_HAS_NET_CHKSUM is true. Computes the one's
+ * complement sum of the 16-bit words of the buffer, as described in
+ * RFC 1071, without complementing it. An odd last byte is padded with
+ * a zero byte.
+ *
+ * @param data Start of the buffer, of any alignment
+ * @param len Length of the buffer in bytes
+ *
+ * @return The sum folded to 16 bits, in the byte order of the buffer,
+ *         i.e. network byte order
+ */
+uint16_t arch_net_chksum(const uint8_t *data, size_t len);
+#endif
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
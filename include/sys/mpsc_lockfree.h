@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free intrusive multi-producer single-consumer queue
+ *
+ * A FIFO of intrusive nodes that any number of producers, including
+ * ISRs and threads on other CPUs, may push to concurrently without
+ * locks, while a single consumer pops from it.  Pushing costs one
+ * atomic exchange and one atomic store and is wait-free.  Popping is
+ * lock-free, but is only safe from one context at a time; serializing
+ * consumers is up to the user.
+ *
+ * A pop that races with a push still in progress may report the
+ * queue as empty even though the producer already started linking
+ * its node.  The node becomes visible as soon as that push completes.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue node, to be embedded in the queued items
+ */
+struct mpsc_node {
+	atomic_ptr_t next;
+};
+
+/**
+ * @brief MPSC queue
+ *
+ * Producers swap themselves into @a head, the consumer walks from
+ * @a tail.  The embedded @a stub node keeps the list non-empty so
+ * that producers never need to touch the consumer's end.
+ */
+struct mpsc {
+	atomic_ptr_t head;
+	struct mpsc_node *tail;
+	struct mpsc_node stub;
+};
+
+/**
+ * @brief Statically initialize a MPSC queue
+ *
+ * @param symbol Name of the queue variable being initialized
+ */
+#define MPSC_INIT(symbol)			\
+	{					\
+		.head = &(symbol).stub,		\
+		.tail = &(symbol).stub,		\
+		.stub = {			\
+			.next = NULL,		\
+		},				\
+	}
+
+/**
+ * @brief Initialize a MPSC queue
+ *
+ * @param q Queue to initialize
+ */
+static inline void mpsc_init(struct mpsc *q)
+{
+	atomic_ptr_set(&q->head, &q->stub);
+	q->tail = &q->stub;
+	atomic_ptr_clear(&q->stub.next);
+}
+
+/**
+ * @brief Push a node onto the queue
+ *
+ * May be called concurrently from any number of threads and ISRs on
+ * any CPU.
+ *
+ * @param q Queue to push to
+ * @param n Node to push, must not currently be in the queue
+ */
+void mpsc_push(struct mpsc *q, struct mpsc_node *n);
+
+/**
+ * @brief Pop the oldest node from the queue
+ *
+ * Must only be called by the single consumer of the queue.
+ *
+ * @param q Queue to pop from
+ * @return The oldest node, or NULL if the queue is empty or the only
+ *         remaining push is still in progress
+ */
+struct mpsc_node *mpsc_pop(struct mpsc *q);
+
+/**
+ * @brief Check whether the queue is empty
+ *
+ * Like mpsc_pop(), a push still in progress may go unnoticed.
+ *
+ * @param q Queue to check
+ * @return true if there is no node to pop
+ */
+static inline bool mpsc_is_empty(struct mpsc *q)
+{
+	return q->tail == &q->stub &&
+		atomic_ptr_get(&q->stub.next) == NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_LOCKFREE_H_ */
@@ -54,6 +54,12 @@ struct sys_heap {
 	size_t init_bytes;
 };
 
+struct sys_heap_stats {
+	size_t free_bytes;
+	size_t allocated_bytes;
+	size_t largest_free_bytes;
+};
+
 struct z_heap_stress_result {
 	uint32_t total_allocs;
 	uint32_t successful_allocs;
@@ -118,6 +124,66 @@ void *sys_heap_aligned_alloc(struct sys_heap *h, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *h, void *mem);
 
+/** @brief Resize an existing allocation
+ *
+ * Returns a pointer to a block of at least @a bytes bytes with the
+ * same contents as @a ptr up to the smaller of the old and new
+ * sizes.  Whenever possible the block is resized in place: shrinking
+ * splits off and frees the unused tail, and growing absorbs (part
+ * of) a free chunk immediately to the right.  Only when neither is
+ * possible is a new block allocated, the data copied and the old
+ * block freed.
+ *
+ * As with ISO C realloc(), a NULL @a ptr behaves like
+ * sys_heap_alloc() and a zero @a bytes like sys_heap_free().  On
+ * failure NULL is returned and the original block is left intact.
+ * A block from sys_heap_aligned_alloc() keeps its alignment when
+ * resized in place but not when it has to move.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param h Heap from which to allocate
+ * @param ptr Original pointer returned from a previous allocation
+ * @param bytes Number of bytes requested for the new block
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_realloc(struct sys_heap *h, void *ptr, size_t bytes);
+
+/** @brief Get the usable size of an allocated block
+ *
+ * Returns the number of bytes the caller may use at @a mem, which
+ * is at least the size originally requested and may be larger due
+ * to the chunk granularity of the heap.
+ *
+ * @note Only the chunk header of the block itself is read, which
+ * nothing else modifies while the block is allocated, so this may
+ * be called without holding the lock protecting the heap.
+ *
+ * @param h Heap the block was allocated from
+ * @param mem A pointer previously returned from sys_heap_alloc() or
+ *            sys_heap_aligned_alloc()
+ * @return Usable size of the block in bytes
+ */
+size_t sys_heap_usable_size(struct sys_heap *h, void *mem);
+
+/** @brief Gather heap usage statistics
+ *
+ * Walks the whole heap and reports free and allocated byte counts
+ * (excluding chunk headers) and the size of the largest free block,
+ * from which fragmentation can be derived.  This takes time linear
+ * in the number of chunks and is intended for diagnostics.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param h Heap to inspect
+ * @param stats Struct into which to store the statistics
+ */
+void sys_heap_stats_get(struct sys_heap *h, struct sys_heap_stats *stats);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
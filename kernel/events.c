@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Event objects
+ *
+ * An event object holds 32 independent events.  Threads wait in a single
+ * wait queue for any or all of a subset of them, describing what they
+ * wait for in a z_event_waiter on their stack.  Setting events readies
+ * every waiter that is satisfied, in wait queue order, under the
+ * scheduler lock.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <syscall_handler.h>
+#include <kernel_internal.h>
+
+struct z_event_waiter {
+	uint32_t events;	/* Events waited for */
+	uint32_t matched;	/* Events that satisfied the wait */
+	bool all;		/* Wait for all events rather than any */
+	bool clear;		/* Consume the matched events */
+};
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	event->lock = (struct k_spinlock) {};
+	z_waitq_init(&event->wait_q);
+#if defined(CONFIG_POLL)
+	sys_dlist_init(&event->poll_events);
+#endif
+
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_init(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init(event);
+}
+#include <syscalls/k_event_init_mrsh.c>
+#endif
+
+static inline struct z_event_waiter *event_waiter(struct k_thread *thread)
+{
+	return thread->base.swap_data;
+}
+
+static inline uint32_t event_match(uint32_t current, uint32_t events,
+				   bool all)
+{
+	if (all) {
+		return ((current & events) == events) ? events : 0U;
+	}
+	return current & events;
+}
+
+static inline void handle_poll_events(struct k_event *event)
+{
+#ifdef CONFIG_POLL
+	/* Unlike a semaphore count, events are seen by every poller */
+	while (!sys_dlist_is_empty(&event->poll_events)) {
+		z_handle_obj_poll_events(&event->poll_events,
+					 K_POLL_STATE_EVENTS);
+	}
+#else
+	ARG_UNUSED(event);
+#endif
+}
+
+/* Picks a waiter satisfied by the events, consuming the matched events
+ * if it asked to, called under the scheduler lock by z_sched_wake_if().
+ */
+static bool event_wake(struct k_thread *thread, void *data)
+{
+	struct k_event *event = data;
+	struct z_event_waiter *waiter = event_waiter(thread);
+	uint32_t matched;
+
+	matched = event_match(event->events, waiter->events, waiter->all);
+	if (matched == 0U) {
+		return false;
+	}
+
+	waiter->matched = matched;
+	if (waiter->clear) {
+		event->events &= ~matched;
+	}
+
+	return true;
+}
+
+void z_impl_k_event_set(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+
+	event->events |= events;
+
+	/* Only threads still pending when the scheduler lock is taken are
+	 * picked, so no events are consumed for a thread that timed out.
+	 */
+	(void)z_sched_wake_if(&event->wait_q, event_wake, event);
+
+	if (event->events != 0U) {
+		handle_poll_events(event);
+	}
+
+	z_reschedule(&event->lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_set(struct k_event *event,
+				      uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_set(event, events);
+}
+#include <syscalls/k_event_set_mrsh.c>
+#endif
+
+void z_impl_k_event_clear(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+
+	event->events &= ~events;
+
+	k_spin_unlock(&event->lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_clear(struct k_event *event,
+					uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_clear(event, events);
+}
+#include <syscalls/k_event_clear_mrsh.c>
+#endif
+
+static uint32_t event_wait(struct k_event *event, uint32_t events,
+			   bool all, bool clear, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(events != 0U, "no events to wait for");
+
+	struct z_event_waiter waiter;
+	k_spinlock_key_t key;
+	uint32_t matched;
+
+	key = k_spin_lock(&event->lock);
+
+	matched = event_match(event->events, events, all);
+	if (matched != 0U) {
+		if (clear) {
+			event->events &= ~matched;
+		}
+		k_spin_unlock(&event->lock, key);
+		return matched;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&event->lock, key);
+		return 0U;
+	}
+
+	waiter = (struct z_event_waiter) {
+		.events = events,
+		.all = all,
+		.clear = clear,
+	};
+	_current->base.swap_data = &waiter;
+
+	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) != 0) {
+		return 0U;
+	}
+
+	return waiter.matched;
+}
+
+uint32_t z_impl_k_event_wait(struct k_event *event, uint32_t events,
+			     bool clear, k_timeout_t timeout)
+{
+	return event_wait(event, events, false, clear, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_wait(struct k_event *event,
+					   uint32_t events, bool clear,
+					   k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	Z_OOPS(Z_SYSCALL_VERIFY(events != 0U));
+	return z_impl_k_event_wait(event, events, clear, timeout);
+}
+#include <syscalls/k_event_wait_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_wait_all(struct k_event *event, uint32_t events,
+				 bool clear, k_timeout_t timeout)
+{
+	return event_wait(event, events, true, clear, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_wait_all(struct k_event *event,
+					       uint32_t events, bool clear,
+					       k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	Z_OOPS(Z_SYSCALL_VERIFY(events != 0U));
+	return z_impl_k_event_wait_all(event, events, clear, timeout);
+}
+#include <syscalls/k_event_wait_all_mrsh.c>
+
+static inline uint32_t z_vrfy_k_event_get(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_get(event);
+}
+#include <syscalls/k_event_get_mrsh.c>
+#endif
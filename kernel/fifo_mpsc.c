@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
+
+/* Producers only take the lock when the consumer announced, through
+ * the pending flag, that it is about to sleep.  The consumer sets the
+ * flag before its last look at the queue and a producer checks it
+ * after its push has completed, both with sequentially consistent
+ * atomics, so either the consumer sees the new item or the producer
+ * sees the flag.  The lock then orders the wakeup against the
+ * consumer actually pending.
+ */
+
+void k_fifo_mpsc_init(struct k_fifo_mpsc *fifo)
+{
+	mpsc_init(&fifo->queue);
+	atomic_clear(&fifo->pending);
+	z_waitq_init(&fifo->wait_q);
+	fifo->lock = (struct k_spinlock) {};
+}
+
+void k_fifo_mpsc_put(struct k_fifo_mpsc *fifo, void *data)
+{
+	mpsc_push(&fifo->queue, data);
+
+	if (atomic_get(&fifo->pending) == 0) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&fifo->lock);
+	struct k_thread *thread = z_unpend_first_thread(&fifo->wait_q);
+
+	if (thread != NULL) {
+		z_ready_thread(thread);
+		z_reschedule(&fifo->lock, key);
+	} else {
+		k_spin_unlock(&fifo->lock, key);
+	}
+}
+
+void *k_fifo_mpsc_get(struct k_fifo_mpsc *fifo, k_timeout_t timeout)
+{
+	void *data = mpsc_pop(&fifo->queue);
+
+	if (likely(data != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return data;
+	}
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	int64_t now, end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&fifo->lock);
+
+	__ASSERT(z_waitq_head(&fifo->wait_q) == NULL,
+		 "only a single consumer may wait on a lock-free FIFO");
+
+	while (true) {
+		atomic_set(&fifo->pending, 1);
+		data = mpsc_pop(&fifo->queue);
+		if (data != NULL) {
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if ((end - now) <= 0) {
+				break;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+		(void) z_pend_curr(&fifo->lock, key, &fifo->wait_q, timeout);
+		key = k_spin_lock(&fifo->lock);
+	}
+
+	atomic_clear(&fifo->pending);
+	k_spin_unlock(&fifo->lock, key);
+
+	return data;
+}
@@ -51,6 +51,15 @@ void z_reschedule_irqlock(uint32_t key);
 struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q);
 void z_unpend_thread(struct k_thread *thread);
 int z_unpend_all(_wait_q_t *wait_q);
+
+/* Wakes, with a return value of 0, every thread pending on wait_q for
+ * which func returns true.  func is called under the scheduler lock, once
+ * per thread in wait queue order, and must not block.  Returns the number
+ * of threads woken.
+ */
+int z_sched_wake_if(_wait_q_t *wait_q,
+		    bool (*func)(struct k_thread *thread, void *data),
+		    void *data);
 void z_thread_priority_set(struct k_thread *thread, int prio);
 bool z_set_prio(struct k_thread *thread, int prio);
 void *z_get_next_switch_handle(void *interrupted);
@@ -8,11 +8,16 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <init.h>
+#include <string.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_K_HEAP_CACHE
+	(void)memset(h->cache, 0, sizeof(h->cache));
+	atomic_clear(&h->cache_waiters);
+#endif
 }
 
 static int statics_init(const struct device *unused)
@@ -26,10 +31,182 @@ static int statics_init(const struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_K_HEAP_CACHE
+/* Size classes are powers of two from 16 bytes, big enough for the
+ * link pointer stored in cached blocks.  The fast paths only take the
+ * lock of the current CPU's cache, which is uncontended unless the
+ * slow path of another CPU is draining it, so they don't need the
+ * heap lock.
+ */
+#define CACHE_MIN_SHIFT 4
+#define CACHE_CLASSES CONFIG_K_HEAP_CACHE_CLASSES
+#define CACHE_CLASS_SIZE(cls) ((size_t)1 << ((cls) + CACHE_MIN_SHIFT))
+#define CACHE_MAX_SIZE CACHE_CLASS_SIZE(CACHE_CLASSES - 1)
+
+/* Takes a block for a request of *bytes from the current CPU's
+ * magazine.  On a miss, rounds *bytes up to the size class so that
+ * the block the heap hands out can be cached once freed.
+ */
+static void *cache_alloc(struct k_heap *h, size_t *bytes)
+{
+	if (*bytes == 0U || *bytes > CACHE_MAX_SIZE) {
+		return NULL;
+	}
+
+	int cls = *bytes <= CACHE_CLASS_SIZE(0) ? 0
+		: 32 - __builtin_clz(*bytes - 1) - CACHE_MIN_SHIFT;
+	unsigned int key = arch_irq_lock();
+	struct z_heap_cache *cache = &h->cache[_current_cpu->id];
+	k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+	struct z_heap_magazine *mag = &cache->mag[cls];
+	void *ret = mag->head;
+
+	if (ret != NULL) {
+		mag->head = *(void **)ret;
+		mag->count--;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, ckey);
+	arch_irq_unlock(key);
+
+	*bytes = CACHE_CLASS_SIZE(cls);
+	return ret;
+}
+
+/* Returns true if the block was kept in the current CPU's magazine */
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	size_t usable = sys_heap_usable_size(&h->heap, mem);
+
+	if (usable < CACHE_CLASS_SIZE(0)) {
+		return false;
+	}
+
+	/* Largest class the block can serve; don't cache blocks more
+	 * than twice the size of the top class
+	 */
+	int cls = 31 - __builtin_clz(usable) - CACHE_MIN_SHIFT;
+
+	if (cls >= CACHE_CLASSES) {
+		return false;
+	}
+
+	bool cached = false;
+	unsigned int key = arch_irq_lock();
+	struct z_heap_cache *cache = &h->cache[_current_cpu->id];
+	k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+	struct z_heap_magazine *mag = &cache->mag[cls];
+
+	/* Memory must go back to the heap while a thread is about to
+	 * pend on it.  The count is raised before that thread checks
+	 * this cache under its lock, so the block either goes to the
+	 * heap here, which wakes it, or is seen by cache_wait_begin().
+	 */
+	if (atomic_get(&h->cache_waiters) == 0 &&
+	    mag->count < CONFIG_K_HEAP_CACHE_DEPTH) {
+		*(void **)mem = mag->head;
+		mag->head = mem;
+		mag->count++;
+		cache->cached_frees++;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, ckey);
+	arch_irq_unlock(key);
+
+	return cached;
+}
+
+/* Returns the cached blocks of every CPU to the heap, must be called
+ * without the heap lock.  Each magazine is detached under its cache
+ * lock and its blocks freed under one heap lock hold, so the heap lock
+ * is held for CONFIG_K_HEAP_CACHE_DEPTH frees at most.
+ */
+static void cache_drain(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cache *cache = &h->cache[i];
+
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			struct z_heap_magazine *mag = &cache->mag[cls];
+			k_spinlock_key_t key = k_spin_lock(&cache->lock);
+			void *mem = mag->head;
+
+			mag->head = NULL;
+			mag->count = 0;
+			k_spin_unlock(&cache->lock, key);
+
+			if (mem == NULL) {
+				continue;
+			}
+
+			key = k_spin_lock(&h->lock);
+			while (mem != NULL) {
+				void *next = *(void **)mem;
+
+				sys_heap_free(&h->heap, mem);
+				mem = next;
+			}
+
+			/* Threads may have pended since the magazine was
+			 * detached
+			 */
+			if (z_unpend_all(&h->wait_q) != 0) {
+				z_reschedule(&h->lock, key);
+			} else {
+				k_spin_unlock(&h->lock, key);
+			}
+		}
+	}
+}
+
+/* Raises the count of threads about to pend on the heap, which must be
+ * locked.  From then on frees bypass the magazines and wake the
+ * waiters, but blocks cached before must still be drained.  Returns
+ * false, with the count restored, if any magazine holds blocks.
+ */
+static bool cache_wait_begin(struct k_heap *h)
+{
+	atomic_inc(&h->cache_waiters);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cache *cache = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+		bool empty = true;
+
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			empty = empty && cache->mag[cls].head == NULL;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+
+		if (!empty) {
+			atomic_dec(&h->cache_waiters);
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_K_HEAP_CACHE */
+
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 {
 	int64_t now, end = z_timeout_end_calc(timeout);
 	void *ret = NULL;
+
+#ifdef CONFIG_K_HEAP_CACHE
+	bool drained = false;
+
+	ret = cache_alloc(h, &bytes);
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -37,14 +214,44 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	while (ret == NULL) {
 		ret = sys_heap_alloc(&h->heap, bytes);
 
-		now = z_tick_get();
-		if ((ret != NULL) || ((end - now) <= 0)) {
+		if (ret != NULL) {
 			break;
 		}
 
-		(void) z_pend_curr(&h->lock, key, &h->wait_q,
-				   K_TICKS(end - now));
+#ifdef CONFIG_K_HEAP_CACHE
+		/* Return the cached blocks of all CPUs before failing
+		 * or pending, outside of the heap lock
+		 */
+		if (!drained) {
+			k_spin_unlock(&h->lock, key);
+			cache_drain(h);
+			drained = true;
+			key = k_spin_lock(&h->lock);
+			continue;
+		}
+#endif
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if ((end - now) <= 0) {
+				break;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+#ifdef CONFIG_K_HEAP_CACHE
+		drained = false;
+		if (!cache_wait_begin(h)) {
+			continue;
+		}
+#endif
+
+		(void) z_pend_curr(&h->lock, key, &h->wait_q, timeout);
 		key = k_spin_lock(&h->lock);
+
+#ifdef CONFIG_K_HEAP_CACHE
+		atomic_dec(&h->cache_waiters);
+#endif
 	}
 
 	k_spin_unlock(&h->lock, key);
@@ -53,6 +260,12 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_K_HEAP_CACHE
+	if (mem != NULL && cache_free(h, mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
@@ -64,6 +277,107 @@ void k_heap_free(struct k_heap *h, void *mem)
 	}
 }
 
+void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes,
+		     k_timeout_t timeout)
+{
+	if (ptr == NULL) {
+		return k_heap_alloc(h, bytes, timeout);
+	}
+	if (bytes == 0U) {
+		k_heap_free(h, ptr);
+		return NULL;
+	}
+
+	int64_t now, end = z_timeout_end_calc(timeout);
+	void *ret = NULL;
+#ifdef CONFIG_K_HEAP_CACHE
+	bool drained = false;
+#endif
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	while (ret == NULL) {
+		ret = sys_heap_realloc(&h->heap, ptr, bytes);
+
+		if (ret != NULL) {
+			break;
+		}
+
+#ifdef CONFIG_K_HEAP_CACHE
+		if (!drained) {
+			k_spin_unlock(&h->lock, key);
+			cache_drain(h);
+			drained = true;
+			key = k_spin_lock(&h->lock);
+			continue;
+		}
+#endif
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if ((end - now) <= 0) {
+				break;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+#ifdef CONFIG_K_HEAP_CACHE
+		drained = false;
+		if (!cache_wait_begin(h)) {
+			continue;
+		}
+#endif
+
+		(void) z_pend_curr(&h->lock, key, &h->wait_q, timeout);
+		key = k_spin_lock(&h->lock);
+
+#ifdef CONFIG_K_HEAP_CACHE
+		atomic_dec(&h->cache_waiters);
+#endif
+	}
+
+	/* Shrinking or moving the block may have freed memory */
+	if (ret != NULL && z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+	return ret;
+}
+
+void k_heap_stats_get(struct k_heap *h, struct k_heap_stats *stats)
+{
+	struct sys_heap_stats heap_stats;
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	sys_heap_stats_get(&h->heap, &heap_stats);
+	k_spin_unlock(&h->lock, key);
+
+	*stats = (struct k_heap_stats) {
+		.free_bytes = heap_stats.free_bytes,
+		.allocated_bytes = heap_stats.allocated_bytes,
+		.largest_free_bytes = heap_stats.largest_free_bytes,
+	};
+
+#ifdef CONFIG_K_HEAP_CACHE
+	/* Other CPUs' counters are read racily, which is fine for
+	 * statistics
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cache *cache = &h->cache[i];
+
+		stats->cache_hits += cache->hits;
+		stats->cache_misses += cache->misses;
+		stats->cached_frees += cache->cached_frees;
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			stats->cached_bytes +=
+				cache->mag[cls].count * CACHE_CLASS_SIZE(cls);
+		}
+	}
+#endif
+}
+
 #ifdef CONFIG_MEM_POOL_HEAP_BACKEND
 /* Compatibility layer for legacy k_mem_pool code on top of a k_heap
  * backend.
@@ -56,8 +56,12 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+	msgq->put_claim = NULL;
+	msgq->get_claim = NULL;
+	msgq->get_claim_owner = NULL;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->claim_wait_q);
 	msgq->lock = (struct k_spinlock) {};
 
 	SYS_TRACING_OBJ_INIT(k_msgq, msgq);
@@ -101,7 +105,8 @@ int z_vrfy_k_msgq_alloc_init(struct k_msgq *q, size_t msg_size,
 
 int k_msgq_cleanup(struct k_msgq *msgq)
 {
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL ||
+		z_waitq_head(&msgq->claim_wait_q) != NULL) {
 		return -EBUSY;
 	}
 
@@ -113,6 +118,64 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+/*
+ * Zero-copy claims.  A put claim reserves the slot at write_ptr and a
+ * get claim the message at read_ptr, at most one of each at a time.
+ * Threads that find the end of the queue they need claimed, and
+ * claimers that find the queue full or empty, wait on claim_wait_q
+ * and retry whenever the queue changes state.  This keeps wait_q for
+ * the copying API alone, where waiting threads are all receivers
+ * (queue empty) or all senders (queue full) and are handed messages
+ * directly.
+ */
+
+static inline void msgq_ptr_advance(struct k_msgq *msgq, char **ptr)
+{
+	*ptr += msgq->msg_size;
+	if (*ptr == msgq->buffer_end) {
+		*ptr = msgq->buffer_start;
+	}
+}
+
+/* Must be called with the lock held, returns true if a reschedule
+ * is needed
+ */
+static bool msgq_claim_wake(struct k_msgq *msgq)
+{
+	if (z_waitq_head(&msgq->claim_wait_q) == NULL) {
+		return false;
+	}
+	return z_unpend_all(&msgq->claim_wait_q) != 0;
+}
+
+/* Owner recorded for a message claimed by the caller */
+static inline struct k_thread *msgq_claimer(void)
+{
+	return arch_is_in_isr() ? NULL : _current;
+}
+
+/* Waits for the queue to change state, called and returning with the
+ * lock held.  Leaves what remains of the waiting period in timeout.
+ */
+static int msgq_claim_wait(struct k_msgq *msgq, k_spinlock_key_t *key,
+			   k_timeout_t *timeout)
+{
+	int64_t end = z_timeout_end_calc(*timeout);
+
+	(void)z_pend_curr(&msgq->lock, *key, &msgq->claim_wait_q, *timeout);
+	*key = k_spin_lock(&msgq->lock);
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		int64_t left = end - z_tick_get();
+
+		if (left <= 0) {
+			return -EAGAIN;
+		}
+		*timeout = K_TICKS(left);
+	}
+	return 0;
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -123,6 +186,16 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	key = k_spin_lock(&msgq->lock);
 
+	/* Queue behind a sender filling in a claimed slot */
+	while (msgq->put_claim != NULL) {
+		result = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY :
+			msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			k_spin_unlock(&msgq->lock, key);
+			return result;
+		}
+	}
+
 	if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -138,11 +211,12 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		} else {
 			/* put message in queue */
 			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_ptr_advance(msgq, &msgq->write_ptr);
 			msgq->used_msgs++;
+			if (msgq_claim_wake(msgq)) {
+				z_reschedule(&msgq->lock, key);
+				return 0;
+			}
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -171,6 +245,105 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *q, const void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+/* Number of messages that can be copied to or from ptr without
+ * wrapping around the ring buffer
+ */
+static inline uint32_t msgq_run_length(struct k_msgq *msgq, char *ptr)
+{
+	return (msgq->buffer_end - ptr) / msgq->msg_size;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t run;
+	bool resched = false;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* Queue behind a sender filling in a claimed slot */
+	while (msgq->put_claim != NULL) {
+		result = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY :
+			msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			k_spin_unlock(&msgq->lock, key);
+			return result;
+		}
+	}
+
+	/* Receivers only wait in wait_q while the queue is empty */
+	while (count < num_msgs && msgq->used_msgs == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+		(void)memcpy(pending_thread->base.swap_data, src,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		src += msgq->msg_size;
+		count++;
+		resched = true;
+	}
+
+	while (count < num_msgs && msgq->used_msgs < msgq->max_msgs) {
+		run = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+		run = MIN(run, msgq_run_length(msgq, msgq->write_ptr));
+		(void)memcpy(msgq->write_ptr, src, run * msgq->msg_size);
+		msgq->write_ptr += run * msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs += run;
+		src += run * msgq->msg_size;
+		count += run;
+	}
+
+	if (count == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* Queue is full, wait to hand over the first message */
+		_current->base.swap_data = (void *)data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (msgq_claim_wake(msgq) || resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *q, const void *data,
+					 uint32_t num_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_put_many(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -199,13 +372,20 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	key = k_spin_lock(&msgq->lock);
 
+	/* Queue behind a receiver reading a claimed message */
+	while (msgq->get_claim != NULL) {
+		result = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY :
+			msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			k_spin_unlock(&msgq->lock, key);
+			return result;
+		}
+	}
+
 	if (msgq->used_msgs > 0) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
+		msgq_ptr_advance(msgq, &msgq->read_ptr);
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
@@ -214,10 +394,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 			/* add thread's message to queue */
 			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
 			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_ptr_advance(msgq, &msgq->write_ptr);
 			msgq->used_msgs++;
 
 			/* wake up waiting thread */
@@ -226,6 +403,11 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 			z_reschedule(&msgq->lock, key);
 			return 0;
 		}
+
+		if (msgq_claim_wake(msgq)) {
+			z_reschedule(&msgq->lock, key);
+			return 0;
+		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
@@ -253,6 +435,237 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *q, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t run;
+	bool resched = false;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* Queue behind a receiver reading a claimed message */
+	while (msgq->get_claim != NULL) {
+		result = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY :
+			msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			k_spin_unlock(&msgq->lock, key);
+			return result;
+		}
+	}
+
+	while (count < num_msgs && msgq->used_msgs > 0U) {
+		run = MIN(num_msgs - count, msgq->used_msgs);
+		run = MIN(run, msgq_run_length(msgq, msgq->read_ptr));
+		(void)memcpy(dst, msgq->read_ptr, run * msgq->msg_size);
+		msgq->read_ptr += run * msgq->msg_size;
+		if (msgq->read_ptr == msgq->buffer_end) {
+			msgq->read_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs -= run;
+		dst += run * msgq->msg_size;
+		count += run;
+	}
+
+	/* Senders only wait in wait_q while the queue is full.  Their
+	 * messages come after everything in the ring buffer, so they go
+	 * straight to the caller if it still has room, which implies
+	 * the ring buffer is empty, or into the freed slots otherwise.
+	 */
+	while (msgq->used_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+		if (count < num_msgs) {
+			(void)memcpy(dst, pending_thread->base.swap_data,
+				     msgq->msg_size);
+			dst += msgq->msg_size;
+			count++;
+		} else {
+			(void)memcpy(msgq->write_ptr,
+				     pending_thread->base.swap_data,
+				     msgq->msg_size);
+			msgq_ptr_advance(msgq, &msgq->write_ptr);
+			msgq->used_msgs++;
+		}
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if (count == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* Queue is empty, wait to be handed the first message */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (msgq_claim_wake(msgq) || resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *q, void *data,
+					 uint32_t num_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_many(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
+int k_msgq_put_claim(struct k_msgq *msgq, void **slot, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	while (true) {
+		if (msgq->put_claim == NULL &&
+		    msgq->used_msgs < msgq->max_msgs) {
+			msgq->put_claim = msgq->write_ptr;
+			*slot = msgq->put_claim;
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = (msgq->put_claim != NULL) ? -EBUSY : -ENOMSG;
+			break;
+		}
+
+		result = msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+void k_msgq_put_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *pending_thread = NULL;
+
+	__ASSERT(msgq->put_claim == msgq->write_ptr, "no slot claimed");
+	msgq->put_claim = NULL;
+
+	/* Receivers only wait in wait_q while the queue is empty */
+	if (msgq->used_msgs == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	}
+
+	if (pending_thread != NULL) {
+		/* give message to waiting thread, the slot stays free */
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	} else {
+		msgq_ptr_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+	}
+
+	(void)msgq_claim_wake(msgq);
+	z_reschedule(&msgq->lock, key);
+}
+
+int k_msgq_get_claim(struct k_msgq *msgq, void **slot, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	while (true) {
+		if (msgq->get_claim == NULL && msgq->used_msgs > 0U) {
+			msgq->get_claim = msgq->read_ptr;
+			msgq->get_claim_owner = msgq_claimer();
+			*slot = msgq->get_claim;
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = (msgq->get_claim != NULL) ? -EBUSY : -ENOMSG;
+			break;
+		}
+
+		result = msgq_claim_wait(msgq, &key, &timeout);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+void k_msgq_get_release(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *pending_thread;
+
+	if (msgq->get_claim == NULL ||
+	    msgq->get_claim_owner != msgq_claimer()) {
+		/* message was purged while claimed, the current claim if
+		 * any was taken since
+		 */
+		k_spin_unlock(&msgq->lock, key);
+		return;
+	}
+
+	__ASSERT(msgq->get_claim == msgq->read_ptr, "");
+	msgq->get_claim = NULL;
+	msgq_ptr_advance(msgq, &msgq->read_ptr);
+	msgq->used_msgs--;
+
+	/* Senders only wait in wait_q while the queue is full, which
+	 * also means no slot is claimed
+	 */
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+			     msgq->msg_size);
+		msgq_ptr_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	}
+
+	(void)msgq_claim_wake(msgq);
+	z_reschedule(&msgq->lock, key);
+}
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -300,7 +713,9 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	msgq->get_claim = NULL;
 
+	(void)msgq_claim_wake(msgq);
 	z_reschedule(&msgq->lock, key);
 }
 
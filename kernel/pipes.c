@@ -780,6 +780,119 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #include <syscalls/k_pipe_put_mrsh.c>
 #endif
 
+int k_pipe_put_vec(struct k_pipe *pipe, const struct k_pipe_vec *vec,
+		   size_t vec_count, size_t *bytes_written,
+		   k_timeout_t timeout)
+{
+	size_t xfer;
+	size_t i = 0;
+	int result;
+
+	CHECKIF(bytes_written == NULL) {
+		return -EINVAL;
+	}
+
+	*bytes_written = 0;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * Without waiting readers there is nobody to hand data to
+	 * directly or to wake up, so whole segments can go straight
+	 * into the pipe's circular buffer.
+	 */
+	if (z_waitq_head(&pipe->wait_q.readers) == NULL) {
+		while ((i < vec_count) &&
+		       (vec[i].bytes <= pipe->size - pipe->bytes_used)) {
+			*bytes_written += pipe_buffer_put(pipe, vec[i].data,
+							  vec[i].bytes);
+			i++;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	if (i < vec_count) {
+		/* Readers only get to run once all segments are written */
+		z_sched_lock();
+		while (i < vec_count) {
+			result = z_pipe_put_internal(pipe, NULL, vec[i].data,
+						     vec[i].bytes, &xfer,
+						     vec[i].bytes, K_NO_WAIT);
+			if (result != 0) {
+				break;
+			}
+			*bytes_written += xfer;
+			i++;
+		}
+		k_sched_unlock();
+	}
+
+	if ((i == 0) && (vec_count > 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = z_pipe_put_internal(pipe, NULL, vec[0].data,
+					     vec[0].bytes, bytes_written,
+					     vec[0].bytes, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	return ((i == 0) && (vec_count > 0)) ? -EIO : (int)i;
+}
+
+int k_pipe_get_vec(struct k_pipe *pipe, const struct k_pipe_vec *vec,
+		   size_t vec_count, size_t *bytes_read, k_timeout_t timeout)
+{
+	size_t xfer;
+	size_t i = 0;
+	int result;
+
+	CHECKIF(bytes_read == NULL) {
+		return -EINVAL;
+	}
+
+	*bytes_read = 0;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * Without waiting writers nothing needs to be moved into the
+	 * freed space or woken up, so whole segments can be taken
+	 * straight from the pipe's circular buffer.
+	 */
+	if (z_waitq_head(&pipe->wait_q.writers) == NULL) {
+		while ((i < vec_count) && (vec[i].bytes <= pipe->bytes_used)) {
+			*bytes_read += pipe_buffer_get(pipe, vec[i].data,
+						       vec[i].bytes);
+			i++;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	if (i < vec_count) {
+		/* Writers only get to run once all segments are filled */
+		z_sched_lock();
+		while (i < vec_count) {
+			result = z_impl_k_pipe_get(pipe, vec[i].data,
+						   vec[i].bytes, &xfer,
+						   vec[i].bytes, K_NO_WAIT);
+			if (result != 0) {
+				break;
+			}
+			*bytes_read += xfer;
+			i++;
+		}
+		k_sched_unlock();
+	}
+
+	if ((i == 0) && (vec_count > 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = z_impl_k_pipe_get(pipe, vec[0].data, vec[0].bytes,
+					   bytes_read, vec[0].bytes, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	return ((i == 0) && (vec_count > 0)) ? -EIO : (int)i;
+}
+
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
 void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 		      size_t bytes_to_write, struct k_sem *sem)
@@ -73,6 +73,12 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			return true;
 		}
 		break;
+	case K_POLL_TYPE_EVENTS:
+		if (event->event->events != 0U) {
+			*state = K_POLL_STATE_EVENTS;
+			return true;
+		}
+		break;
 	case K_POLL_TYPE_IGNORE:
 		break;
 	default:
@@ -124,6 +130,10 @@ static inline int register_event(struct k_poll_event *event,
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		add_event(&event->signal->poll_events, event, poller);
 		break;
+	case K_POLL_TYPE_EVENTS:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		add_event(&event->event->poll_events, event, poller);
+		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -157,6 +167,10 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		remove = true;
 		break;
+	case K_POLL_TYPE_EVENTS:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		remove = true;
+		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -365,6 +379,11 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->queue, K_OBJ_QUEUE));
 			break;
+#ifdef CONFIG_EVENTS
+		case K_POLL_TYPE_EVENTS:
+			Z_OOPS(Z_SYSCALL_OBJ(e->event, K_OBJ_EVENT));
+			break;
+#endif
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -490,6 +509,136 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *signal)
 
 #endif
 
+/* Events of a poll set that occurred are moved to its ready list, which
+ * is what k_poll_set_wait() hands out.  Called with the lock of the
+ * signaled object held, and with the poll lock too for poll signals.
+ */
+static int poll_set_cb(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+	struct k_thread *thread;
+
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	return 0;
+}
+
+/* must be called with the poll lock held */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key;
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (!is_condition_met(event, &state)) {
+		(void)register_event(event, &set->poller);
+		return;
+	}
+
+	key = k_spin_lock(&set->lock);
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_node);
+	k_spin_unlock(&set->lock, key);
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.thread = _current;
+	set->poller.cb = poll_set_cb;
+	set->lock = (struct k_spinlock) {};
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_dnode_init(&event->_node);
+	poll_set_arm(set, event);
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t set_key = k_spin_lock(&set->lock);
+
+	/* The event is either registered with its object, or waiting on
+	 * one of the set's lists
+	 */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&set->lock, set_key);
+	k_spin_unlock(&lock, key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout)
+{
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(max_ready > 0, "no room for ready events\n");
+
+	/* Whatever was handed out last time is looked at again */
+	key = k_spin_lock(&lock);
+	set->poller.thread = _current;
+	while ((event = (struct k_poll_event *)
+			sys_dlist_get(&set->returned)) != NULL) {
+		poll_set_arm(set, event);
+	}
+	k_spin_unlock(&lock, key);
+
+	key = k_spin_lock(&set->lock);
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&set->lock, key);
+			return -EAGAIN;
+		}
+
+		/* Only poll_set_cb() wakes us up, after queuing an event */
+		if (z_pend_curr(&set->lock, key, &set->wait_q, timeout) != 0) {
+			return -EAGAIN;
+		}
+		key = k_spin_lock(&set->lock);
+	}
+
+	while (num_ready < max_ready) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+		sys_dlist_append(&set->returned, &event->_node);
+		ready[num_ready++] = event;
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	return num_ready;
+}
+
 static void triggered_work_handler(struct k_work *work)
 {
 	k_work_handler_t handler;
@@ -41,6 +41,10 @@ LOG_MODULE_DECLARE(os);
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_best		z_priq_bm_best
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
@@ -181,6 +185,156 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+#else
+	ARG_UNUSED(thread);
+	return &_kernel.ready_q.runq;
+#endif
+}
+
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	_priq_run_add(thread_runq(thread), thread);
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(thread_runq(thread), thread);
+}
+
+/* Queues a thread that is running (or just ran) on the current CPU */
+static ALWAYS_INLINE void runq_add_local(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.runq_cpu = _current_cpu->id;
+#endif
+	runq_add(thread);
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+/* True if thread would preempt whatever the CPU is currently running */
+static bool cpu_preemptible(struct _cpu *cpu, struct k_thread *thread)
+{
+	struct k_thread *curr = cpu->current;
+
+	if (curr == NULL) {
+		/* Not started yet */
+		return false;
+	}
+
+	if (z_is_idle_thread_object(curr)) {
+		return true;
+	}
+
+	return (is_preempt(curr) || is_metairq(thread)) &&
+		z_is_t1_higher_prio_than_t2(thread, curr);
+}
+
+/* Picks the CPU whose run queue a newly runnable thread goes to:
+ * the CPU it last ran on if it can run there right away, else an
+ * idle CPU, else any CPU it can preempt, else back where it last ran.
+ */
+static int runq_place(struct k_thread *thread)
+{
+	int last = thread->base.cpu;
+	int fallback = -1;
+
+	if (cpu_allowed(thread, last) &&
+	    cpu_preemptible(&_kernel.cpus[last], thread)) {
+		return last;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if (!cpu_allowed(thread, i)) {
+			continue;
+		}
+
+		if (curr != NULL && z_is_idle_thread_object(curr)) {
+			return i;
+		}
+
+		if (fallback < 0 &&
+		    cpu_preemptible(&_kernel.cpus[i], thread)) {
+			fallback = i;
+		}
+	}
+
+	if (fallback < 0 && !cpu_allowed(thread, last)) {
+		/* Edge case: a thread with all CPUs masked off is
+		 * legal per the API, it just never gets picked.
+		 */
+		fallback = 0;
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (cpu_allowed(thread, i)) {
+				fallback = i;
+				break;
+			}
+		}
+	}
+
+	return fallback < 0 ? last : fallback;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
+/* Best thread for the current CPU that is not _current */
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	struct k_thread *thread = _priq_run_best(&_current_cpu->ready_q.runq);
+
+	/* Work stealing: take the best thread queued on another CPU
+	 * if it outranks our own, which also covers the idle case.
+	 * With CPU masks the backend already skips threads that may
+	 * not run here.
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *t;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if (t != NULL && (thread == NULL ||
+				  z_is_t1_higher_prio_than_t2(t, thread))) {
+			thread = t;
+		}
+	}
+
+	return thread;
+#else
+	return _priq_run_best(&_kernel.ready_q.runq);
+#endif
+}
+
+/* Whether readying a thread needs a scheduler IPI to other CPUs */
+static ALWAYS_INLINE bool ready_needs_ipi(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	int cpu = thread->base.runq_cpu;
+
+	return cpu != _current_cpu->id &&
+		cpu_preemptible(&_kernel.cpus[cpu], thread);
+#else
+	ARG_UNUSED(thread);
+	return true;
+#endif
+}
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 	struct k_thread *thread;
@@ -192,7 +346,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		return _current_cpu->idle_thread;
 	}
 
-	thread = _priq_run_best(&_kernel.ready_q.runq);
+	thread = runq_best();
 
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
@@ -262,13 +416,13 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	/* Put _current back into the queue */
 	if (thread != _current && active &&
 		!z_is_idle_thread_object(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add_local(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 	}
 	z_mark_thread_as_not_queued(thread);
 
@@ -279,9 +433,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
+		runq_add(thread);
+	} else {
+		runq_add_local(thread);
 	}
-	_priq_run_add(&_kernel.ready_q.runq, thread);
 	z_mark_thread_as_queued(thread);
 	update_cache(thread == _current);
 }
@@ -422,11 +578,16 @@ static void ready_thread(struct k_thread *thread)
 	 */
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		sys_trace_thread_ready(thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+		thread->base.runq_cpu = runq_place(thread);
+#endif
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		if (ready_needs_ipi(thread)) {
+			arch_sched_ipi();
+		}
 #endif
 	}
 }
@@ -465,7 +626,7 @@ void z_impl_k_thread_suspend(struct k_thread *thread)
 
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		z_mark_thread_as_suspended(thread);
@@ -552,8 +713,7 @@ void z_thread_single_abort(struct k_thread *thread)
 
 		if (z_is_thread_ready(thread)) {
 			if (z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 			update_cache(thread == _current);
@@ -637,7 +797,7 @@ void z_thread_single_abort(struct k_thread *thread)
 static void unready_thread(struct k_thread *thread)
 {
 	if (z_is_thread_queued(thread)) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
+		runq_remove(thread);
 		z_mark_thread_as_not_queued(thread);
 	}
 	update_cache(thread == _current);
@@ -799,9 +959,9 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		if (need_sched) {
 			/* Don't requeue on SMP if it's the running thread */
 			if (!IS_ENABLED(CONFIG_SMP) || z_is_thread_queued(thread)) {
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				thread->base.prio = prio;
-				_priq_run_add(&_kernel.ready_q.runq, thread);
+				runq_add(thread);
 			} else {
 				thread->base.prio = prio;
 			}
@@ -980,7 +1140,7 @@ ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq, struct k_thread *thread)
 void z_priq_dumb_remove(sys_dlist_t *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_DUMB)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == thread_runq(thread) && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -1045,7 +1205,7 @@ void z_priq_rb_add(struct _priq_rb *pq, struct k_thread *thread)
 void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_SCALABLE)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == thread_runq(thread) && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -1087,7 +1247,7 @@ ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_MULTIQ)
-	if (pq == &_kernel.ready_q.runq && thread == _current &&
+	if (pq == thread_runq(thread) && thread == _current &&
 	    z_is_thread_prevented_from_running(thread)) {
 		return;
 	}
@@ -1116,6 +1276,50 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+#ifdef CONFIG_SCHED_BITMAP
+ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread)
+{
+	unsigned int idx = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	sys_dlist_append(&pq->queues[idx], &thread->base.qnode_dlist);
+	pq->bitmap[idx / 32U] |= BIT(idx % 32U);
+	pq->summary |= BIT(idx / 32U);
+}
+
+ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread)
+{
+#if defined(CONFIG_SWAP_NONATOMIC)
+	if (pq == thread_runq(thread) && thread == _current &&
+	    z_is_thread_prevented_from_running(thread)) {
+		return;
+	}
+#endif
+	unsigned int idx = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+	if (sys_dlist_is_empty(&pq->queues[idx])) {
+		pq->bitmap[idx / 32U] &= ~BIT(idx % 32U);
+		if (pq->bitmap[idx / 32U] == 0U) {
+			pq->summary &= ~BIT(idx / 32U);
+		}
+	}
+}
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	if (!pq->summary) {
+		return NULL;
+	}
+
+	unsigned int word = __builtin_ctz(pq->summary);
+	unsigned int idx = word * 32U + __builtin_ctz(pq->bitmap[word]);
+	sys_dnode_t *n = sys_dlist_peek_head(&pq->queues[idx]);
+
+	return n == NULL ? NULL
+		: CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+#endif /* CONFIG_SCHED_BITMAP */
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1130,25 +1334,77 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+int z_sched_wake_if(_wait_q_t *wait_q,
+		    bool (*func)(struct k_thread *thread, void *data),
+		    void *data)
+{
+	struct k_thread *thread;
+	sys_dlist_t picked;
+	sys_dnode_t *node;
+	int woken = 0;
+
+	/* The wait queue can't change while it is walked, so the threads
+	 * picked in a single walk are woken after it.  Their timeouts are
+	 * aborted first, which leaves the timeout nodes free to hold them
+	 * meanwhile.  Walking and waking under the scheduler lock keeps a
+	 * picked thread from timing out in between.
+	 */
+	sys_dlist_init(&picked);
+
+	LOCKED(&sched_spinlock) {
+		_WAIT_Q_FOR_EACH(wait_q, thread) {
+			if (func(thread, data)) {
+				(void)z_abort_thread_timeout(thread);
+				sys_dlist_append(&picked,
+						 &thread->base.timeout.node);
+			}
+		}
+
+		while ((node = sys_dlist_get(&picked)) != NULL) {
+			thread = CONTAINER_OF(node, struct k_thread,
+					      base.timeout.node);
+			unpend_thread_no_timeout(thread);
+			arch_thread_return_value_set(thread, 0);
+			ready_thread(thread);
+			woken++;
+		}
+	}
+
+	return woken;
+}
+#endif
+
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
 	};
 #endif
 
-#ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_SCHED_BITMAP)
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
+	}
+#else
+	init_ready_q(&_kernel.ready_q);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	k_sched_time_slice_set(CONFIG_TIMESLICE_SIZE,
@@ -1207,8 +1463,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			_priq_run_add(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
+			runq_add(thread);
 		}
 	}
 }
@@ -1237,10 +1493,9 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
+				runq_remove(_current);
 			}
-			_priq_run_add(&_kernel.ready_q.runq, _current);
+			runq_add_local(_current);
 			z_mark_thread_as_queued(_current);
 			update_cache(1);
 		}
@@ -1420,7 +1675,7 @@ void z_sched_abort(struct k_thread *thread)
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
 		} else if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 			thread->base.thread_state |= _THREAD_DEAD;
 			k_spin_unlock(&sched_spinlock, key);
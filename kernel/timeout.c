@@ -19,7 +19,9 @@
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -41,6 +43,195 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* Hierarchical timing wheel.  Each level has WHEEL_SLOTS slots and
+ * indexes WHEEL_BITS more bits of the absolute expiry tick than the
+ * level below it.  A pending timeout lives on the level of the
+ * highest slot digit in which its expiry differs from curr_tick, in
+ * the slot selected by that digit, so its position is a pure
+ * function of (expiry, curr_tick).  z_clock_announce() stops at the
+ * start of every occupied slot and cascades its timeouts down to
+ * lower levels, so by the time curr_tick reaches an expiry the
+ * timeout sits in the level 0 slot of that tick.
+ */
+#define WHEEL_BITS 5
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_RANGE_BITS (WHEEL_BITS * WHEEL_LEVELS)
+
+/* A slot list is only valid while its bit in wheel_occupied[] is
+ * set, and is (re)initialized when the bit gets set, so the wheel
+ * needs no initialization beyond zeroed BSS.
+ */
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t wheel_occupied[WHEEL_LEVELS];
+
+/* Timeouts beyond the range of the wheel, rescanned each time the
+ * top level wraps around.
+ */
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Absolute expiry tick of a pending timeout, stored in dticks.  With
+ * 32 bit timeouts only the low word is kept, which is sufficient as
+ * a pending timeout never lies more than 2^31 ticks past curr_tick.
+ */
+static uint64_t expiry(const struct _timeout *t)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (uint64_t)t->dticks;
+#else
+	uint32_t dt = (uint32_t)t->dticks - (uint32_t)curr_tick;
+
+	return curr_tick + dt;
+#endif
+}
+
+/* Returns WHEEL_LEVELS for timeouts that belong on the overflow list */
+static int wheel_level(uint64_t exp)
+{
+	uint64_t diff = exp ^ curr_tick;
+
+	if (diff == 0ULL) {
+		return 0;
+	}
+
+	return MIN((63 - __builtin_clzll(diff)) / WHEEL_BITS, WHEEL_LEVELS);
+}
+
+static inline uint32_t wheel_slot(uint64_t exp, int level)
+{
+	return (exp >> (level * WHEEL_BITS)) & WHEEL_MASK;
+}
+
+static void wheel_insert(struct _timeout *t, uint64_t exp)
+{
+	int level = wheel_level(exp);
+	uint32_t slot;
+
+	if (level == WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &t->node);
+		return;
+	}
+
+	slot = wheel_slot(exp, level);
+	if ((wheel_occupied[level] & BIT(slot)) == 0U) {
+		sys_dlist_init(&wheel[level][slot]);
+		wheel_occupied[level] |= BIT(slot);
+	}
+
+	sys_dlist_append(&wheel[level][slot], &t->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t exp = expiry(t);
+	int level = wheel_level(exp);
+	uint32_t slot = wheel_slot(exp, level);
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS && sys_dlist_is_empty(&wheel[level][slot])) {
+		wheel_occupied[level] &= ~BIT(slot);
+	}
+}
+
+/* Returns the tick of the next wheel event: the expiry of the
+ * earliest occupied level 0 slot, or else the start of the earliest
+ * occupied slot further up that needs to be cascaded.  Every slot on
+ * a level lies before every slot on the levels above it, so the
+ * first occupied level decides.
+ */
+static uint64_t wheel_next_event(void)
+{
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		int shift = level * WHEEL_BITS;
+		uint32_t cur = wheel_slot(curr_tick, level);
+		uint32_t pending = wheel_occupied[level] & ~(BIT(cur) - 1U);
+
+		if (pending != 0U) {
+			uint64_t base = curr_tick &
+				~((1ULL << (shift + WHEEL_BITS)) - 1ULL);
+			uint64_t slot = __builtin_ctz(pending);
+
+			return base | (slot << shift);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		return ((curr_tick >> WHEEL_RANGE_BITS) + 1ULL)
+			<< WHEEL_RANGE_BITS;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Moves the timeouts of every slot curr_tick just entered to their
+ * new, lower position.  Must be called each time curr_tick reaches
+ * the result of wheel_next_event().
+ */
+static void wheel_cascade(void)
+{
+	sys_dnode_t *node;
+
+	if ((curr_tick & ((1ULL << WHEEL_RANGE_BITS) - 1ULL)) == 0ULL &&
+	    !sys_dlist_is_empty(&wheel_overflow)) {
+		sys_dlist_t far;
+
+		sys_dlist_init(&far);
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&far, node);
+		}
+
+		while ((node = sys_dlist_get(&far)) != NULL) {
+			struct _timeout *t =
+				CONTAINER_OF(node, struct _timeout, node);
+
+			wheel_insert(t, expiry(t));
+		}
+	}
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		uint32_t cur = wheel_slot(curr_tick, level);
+
+		if ((wheel_occupied[level] & BIT(cur)) == 0U) {
+			continue;
+		}
+
+		/* Entries always land on a lower level, never back
+		 * in the slot being drained
+		 */
+		wheel_occupied[level] &= ~BIT(cur);
+		while ((node = sys_dlist_get(&wheel[level][cur])) != NULL) {
+			struct _timeout *t =
+				CONTAINER_OF(node, struct _timeout, node);
+
+			wheel_insert(t, expiry(t));
+		}
+	}
+}
+
+/* Dequeues the next timeout expiring at curr_tick, if any */
+static struct _timeout *wheel_pop_expired(void)
+{
+	uint32_t cur = wheel_slot(curr_tick, 0);
+	sys_dnode_t *node;
+
+	if ((wheel_occupied[0] & BIT(cur)) == 0U) {
+		return NULL;
+	}
+
+	node = sys_dlist_get(&wheel[0][cur]);
+	if (sys_dlist_is_empty(&wheel[0][cur])) {
+		wheel_occupied[0] &= ~BIT(cur);
+	}
+
+	return CONTAINER_OF(node, struct _timeout, node);
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -64,6 +255,8 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0U;
@@ -71,10 +264,17 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t next = wheel_next_event();
+	int64_t dt = (int64_t)MIN(next - curr_tick, (uint64_t)INT_MAX);
+	int32_t ret = next == UINT64_MAX ? MAX_WAIT
+		: MIN(MAX_WAIT, MAX(0, dt - ticks_elapsed));
+#else
+	struct _timeout *to = first();
 	int32_t ret = to == NULL ? MAX_WAIT
 		: MIN(MAX_WAIT, MAX(0, to->dticks - ticks_elapsed));
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -110,6 +310,17 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t prev = wheel_next_event();
+		uint64_t exp = curr_tick + ticks + elapsed();
+
+		to->dticks = exp;
+		wheel_insert(to, exp);
+
+		if (wheel_next_event() < prev) {
+			z_clock_set_timeout(next_timeout(), false);
+		}
+#else
 		struct _timeout *t;
 
 		to->dticks = ticks + elapsed();
@@ -129,6 +340,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -155,12 +367,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = expiry(timeout) - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -231,6 +447,30 @@ void z_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	while (true) {
+		struct _timeout *t = wheel_pop_expired();
+		uint64_t next;
+
+		if (t != NULL) {
+			t->dticks = 0;
+
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+			continue;
+		}
+
+		next = wheel_next_event();
+		if (next - curr_tick > (uint64_t)announce_remaining) {
+			break;
+		}
+
+		announce_remaining -= next - curr_tick;
+		curr_tick = next;
+		wheel_cascade();
+	}
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -248,6 +488,7 @@ void z_clock_announce(int32_t ticks)
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
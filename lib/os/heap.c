@@ -5,6 +5,7 @@
  */
 #include <sys/sys_heap.h>
 #include <kernel.h>
+#include <string.h>
 #include "heap.h"
 
 static void *chunk_mem(struct z_heap *h, chunkid_t c)
@@ -293,6 +294,97 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	return mem;
 }
 
+void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
+{
+	/* ISO C realloc() semantics */
+	if (ptr == NULL) {
+		return sys_heap_alloc(heap, bytes);
+	}
+	if (bytes == 0U) {
+		sys_heap_free(heap, ptr);
+		return NULL;
+	}
+
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, ptr);
+	chunkid_t rc = right_chunk(h, c);
+	size_t align_gap = (uint8_t *)ptr - (uint8_t *)chunk_mem(h, c);
+	size_t chunks_need = bytes_to_chunksz(h, bytes + align_gap);
+
+	if (chunk_size(h, c) >= chunks_need) {
+		/* Shrink in place, split off and free unused suffix */
+		if (chunk_size(h, c) > chunks_need) {
+			split_chunks(h, c, c + chunks_need);
+			set_chunk_used(h, c, true);
+			free_chunk(h, c + chunks_need);
+		}
+		return ptr;
+	}
+
+	if (!chunk_used(h, rc) &&
+	    (chunk_size(h, c) + chunk_size(h, rc) >= chunks_need)) {
+		/* Grow in place into the free right neighbor, splitting
+		 * off and keeping its unneeded suffix free
+		 */
+		size_t split_size = chunks_need - chunk_size(h, c);
+
+		free_list_remove(h, rc);
+		if (split_size < chunk_size(h, rc)) {
+			split_chunks(h, rc, rc + split_size);
+			free_list_add(h, rc + split_size);
+		}
+
+		merge_chunks(h, c, rc);
+		set_chunk_used(h, c, true);
+		return ptr;
+	}
+
+	/* Fall back to allocate, copy and free.  The old block stays
+	 * valid if the allocation fails.
+	 */
+	void *ptr2 = sys_heap_alloc(heap, bytes);
+
+	if (ptr2 != NULL) {
+		size_t prev_size = sys_heap_usable_size(heap, ptr);
+
+		memcpy(ptr2, ptr, MIN(prev_size, bytes));
+		sys_heap_free(heap, ptr);
+	}
+	return ptr2;
+}
+
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	uint8_t *end = (uint8_t *)&chunk_buf(h)[right_chunk(h, c)];
+
+	return end - (uint8_t *)mem;
+}
+
+void sys_heap_stats_get(struct sys_heap *heap, struct sys_heap_stats *stats)
+{
+	struct z_heap *h = heap->heap;
+
+	stats->free_bytes = 0;
+	stats->allocated_bytes = 0;
+	stats->largest_free_bytes = 0;
+
+	for (chunkid_t c = right_chunk(h, 0); c < h->len;
+	     c = right_chunk(h, c)) {
+		size_t bytes = chunk_size(h, c) * CHUNK_UNIT -
+			       chunk_header_bytes(h);
+
+		if (chunk_used(h, c)) {
+			stats->allocated_bytes += bytes;
+		} else {
+			stats->free_bytes += bytes;
+			stats->largest_free_bytes =
+				MAX(stats->largest_free_bytes, bytes);
+		}
+	}
+}
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	/* Must fit in a 32 bit count of HUNK_UNIT */
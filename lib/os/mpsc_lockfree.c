@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <sys/mpsc_lockfree.h>
+
+/* Intrusive MPSC queue after Dmitry Vyukov's design.  The list runs
+ * from the consumer's tail to the producers' head, with each node
+ * pointing at the next newer one.  A producer first swaps itself in
+ * as the new head and only then links the previous head to itself,
+ * so between those two steps the list is briefly cut, which is the
+ * case mpsc_pop() reports as empty.
+ */
+
+void mpsc_push(struct mpsc *q, struct mpsc_node *n)
+{
+	struct mpsc_node *prev;
+
+	atomic_ptr_clear(&n->next);
+	prev = atomic_ptr_set(&q->head, n);
+	atomic_ptr_set(&prev->next, n);
+}
+
+struct mpsc_node *mpsc_pop(struct mpsc *q)
+{
+	struct mpsc_node *tail = q->tail;
+	struct mpsc_node *next = atomic_ptr_get(&tail->next);
+
+	/* Skip over the stub if it is at the tail */
+	if (tail == &q->stub) {
+		if (next == NULL) {
+			return NULL;
+		}
+		q->tail = next;
+		tail = next;
+		next = atomic_ptr_get(&next->next);
+	}
+
+	if (next != NULL) {
+		q->tail = next;
+		return tail;
+	}
+
+	/* tail is the last linked node.  Unless it is also the head,
+	 * a producer is between its swap and its link.
+	 */
+	if (tail != atomic_ptr_get(&q->head)) {
+		return NULL;
+	}
+
+	/* Put the stub back behind the last node so that it can be
+	 * handed out without the list ever becoming empty
+	 */
+	mpsc_push(q, &q->stub);
+
+	next = atomic_ptr_get(&tail->next);
+	if (next != NULL) {
+		q->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
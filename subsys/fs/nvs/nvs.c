@@ -6,6 +6,7 @@
  */
 
 #include <drivers/flash.h>
+#include <init.h>
 #include <string.h>
 #include <errno.h>
 #include <inttypes.h>
@@ -16,6 +17,18 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+BUILD_ASSERT((CONFIG_NVS_LOOKUP_CACHE_SIZE &
+	      (CONFIG_NVS_LOOKUP_CACHE_SIZE - 1)) == 0,
+	     "NVS_LOOKUP_CACHE_SIZE must be a power of two");
+
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+#endif
+
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+#define NVS_GC_BG_IDLE 0xFFFFFFFF
+#endif
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -29,6 +42,48 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 }
 /* end basic routines */
 
+/* lookup cache routines */
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* Every cache position holds the address of the most recent valid ate of
+ * all the ids that hash to it, or NVS_LOOKUP_CACHE_NO_ADDR if there is none.
+ * The latest ate of an id is thus found by walking backwards from the cached
+ * address instead of from fs->ate_wra.
+ */
+static inline uint32_t *nvs_lookup_cache_entry(struct nvs_fs *fs, uint16_t id)
+{
+	uint32_t hash = id * 0x9e3779b1U;
+
+	hash ^= hash >> 16;
+
+	return &fs->lookup_cache[hash & (CONFIG_NVS_LOOKUP_CACHE_SIZE - 1)];
+}
+
+/* start address of a walk looking for the latest ate of id, fs->ate_wra
+ * if the cache does not know it
+ */
+static uint32_t nvs_lookup_cache_start(struct nvs_fs *fs, uint16_t id)
+{
+	uint32_t addr = *nvs_lookup_cache_entry(fs, id);
+
+	if (addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return fs->ate_wra;
+	}
+	return addr;
+}
+
+/* forget all cached addresses within the sector of addr */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t addr)
+{
+	for (int i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] & ADDR_SECT_MASK) ==
+		    (addr & ADDR_SECT_MASK)) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
+/* end lookup cache routines */
+
 /* flash routines */
 /* basic aligned flash write to nvs address */
 static int nvs_flash_al_wrt(struct nvs_fs *fs, uint32_t addr, const void *data,
@@ -106,6 +161,12 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	/* 0xFFFF is the id of the sector close ate */
+	if (!rc && entry->id != 0xFFFF) {
+		*nvs_lookup_cache_entry(fs, entry->id) = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -252,6 +313,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 		return rc;
 	}
 	(void) flash_write_protection_set(fs->flash_device, true);
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	nvs_lookup_cache_invalidate(fs, addr);
+#endif
 	return 0;
 }
 
@@ -466,6 +530,75 @@ static int nvs_sector_close(struct nvs_fs *fs)
 }
 
 
+/* copy the ate read from gc_addr, and its data, to the current sector when it
+ * is the latest valid ate of its id and not a delete. With check_space set the
+ * copy is refused with -ENOSPC unless it leaves space for a delete ate.
+ */
+static int nvs_gc_ate_move(struct nvs_fs *fs, uint32_t gc_addr,
+			   struct nvs_ate *gc_ate, bool check_space)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr, data_addr;
+	size_t ate_size;
+
+	if (nvs_ate_crc8_check(gc_ate)) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = nvs_lookup_cache_start(fs, gc_ate->id);
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (!nvs_ate_crc8_check(&wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr != gc_addr) || !gc_ate->len) {
+		return 0;
+	}
+
+	if (check_space && (fs->ate_wra < fs->data_wra +
+			    nvs_al_size(fs, gc_ate->len) + ate_size)) {
+		return -ENOSPC;
+	}
+
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -473,11 +606,22 @@ static int nvs_sector_close(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	/* the background gc works on the sector that is gc'ed here, it
+	 * starts over from the next sector.
+	 */
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+	if (fs->gc_bg_done) {
+		/* the sector has been emptied by the background gc */
+		fs->gc_bg_done = false;
+		return 0;
+	}
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
@@ -519,59 +663,275 @@ static int nvs_gc(struct nvs_fs *fs)
 			return rc;
 		}
 
-		if (nvs_ate_crc8_check(&gc_ate)) {
-			continue;
+		rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate, false);
+		if (rc) {
+			return rc;
 		}
+	} while (gc_prev_addr != stop_addr);
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (!nvs_ate_crc8_check(&wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
+	rc = nvs_flash_erase_sector(fs, sec_addr);
+	if (rc) {
+		return rc;
+	}
+	return 0;
+}
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+K_THREAD_STACK_DEFINE(nvs_gc_work_q_stack, CONFIG_NVS_BACKGROUND_GC_STACK_SIZE);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+static struct k_work_q nvs_gc_work_q;
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+static int nvs_gc_work_q_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
+	k_work_q_start(&nvs_gc_work_q, nvs_gc_work_q_stack,
+		       K_THREAD_STACK_SIZEOF(nvs_gc_work_q_stack),
+		       K_LOWEST_APPLICATION_THREAD_PRIO);
+	k_thread_name_set(&nvs_gc_work_q.thread, "nvs_gc");
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* background garbage collection: one step of emptying the sector after the
+ * empty one, which holds the oldest data, ahead of nvs_gc(). Its valid ate's
+ * are copied to the current sector one at a time, the sector is erased after
+ * the last one. Returns 1 when there are steps left.
+ */
+static int nvs_gc_bg_step(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate close_ate, gc_ate, gc_done_ate;
+	uint32_t sec_addr, gc_prev_addr;
+	size_t ate_size;
+
+	if (!fs->ready || fs->gc_bg_done || fs->sector_count < 3) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (fs->gc_bg_addr == NVS_GC_BG_IDLE) {
+		sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+		nvs_sector_advance(fs, &sec_addr);
+		nvs_sector_advance(fs, &sec_addr);
+		fs->gc_bg_addr = sec_addr + fs->sector_size - ate_size;
+		fs->gc_bg_stop = fs->gc_bg_addr - ate_size;
+
+		rc = nvs_flash_ate_rd(fs, fs->gc_bg_addr, &close_ate);
+		if (rc) {
+			goto end;
+		}
+
+		rc = nvs_ate_cmp_const(&close_ate,
+				       fs->flash_parameters->erase_value);
+		if (!rc) {
+			/* not closed, there is nothing to copy, and nothing
+			 * to do when it is empty already.
+			 */
+			rc = nvs_flash_cmp_const(fs, sec_addr,
+					fs->flash_parameters->erase_value,
+					fs->sector_size);
+			if (rc > 0) {
+				goto erase;
+			}
+			if (!rc) {
+				fs->gc_bg_done = true;
 			}
+			goto end;
+		}
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+		if (!nvs_ate_crc8_check(&close_ate)) {
+			fs->gc_bg_addr &= ADDR_SECT_MASK;
+			fs->gc_bg_addr += close_ate.offset;
+		} else {
+			rc = nvs_recover_last_ate(fs, &fs->gc_bg_addr);
 			if (rc) {
-				return rc;
+				goto end;
 			}
 		}
-	} while (gc_prev_addr != stop_addr);
+		return 1;
+	}
 
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	gc_prev_addr = fs->gc_bg_addr;
+	rc = nvs_prev_ate(fs, &fs->gc_bg_addr, &gc_ate);
+	if (rc) {
+		goto end;
+	}
+
+	/* when the current sector cannot take the copy the sector is left
+	 * to nvs_gc().
+	 */
+	rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate, true);
+	if (rc) {
+		goto end;
+	}
+
+	if (gc_prev_addr != fs->gc_bg_stop) {
+		return 1;
+	}
+
+erase:
+	/* the gc done ate tells nvs_startup() that the copies are complete,
+	 * in case the erase is interrupted.
+	 */
+	if (fs->ate_wra < fs->data_wra + ate_size) {
+		rc = -ENOSPC;
+		goto end;
+	}
+
+	gc_done_ate.id = 0xFFFF;
+	gc_done_ate.len = 0U;
+	gc_done_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	gc_done_ate.part = 0xff;
+	nvs_ate_crc8_update(&gc_done_ate);
+
+	rc = nvs_flash_ate_wrt(fs, &gc_done_ate);
 	if (rc) {
+		goto end;
+	}
+
+	rc = nvs_flash_erase_sector(fs, fs->gc_bg_stop);
+	if (!rc) {
+		fs->gc_bg_done = true;
+	}
+end:
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+	return rc;
+}
+
+static void nvs_gc_bg_work(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	/* the lock is released between the steps, so writes wait for one
+	 * step at most.
+	 */
+	do {
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+		rc = nvs_gc_bg_step(fs);
+		k_mutex_unlock(&fs->nvs_lock);
+	} while (rc > 0);
+
+	if (rc && rc != -ENOSPC) {
+		LOG_ERR("Background gc failed (%d)", rc);
+	}
+}
+
+struct nvs_gc_bg_flush {
+	struct k_work work;
+	struct k_sem done;
+};
+
+static void nvs_gc_bg_flush_work(struct k_work *work)
+{
+	struct nvs_gc_bg_flush *flush =
+		CONTAINER_OF(work, struct nvs_gc_bg_flush, work);
+
+	k_sem_give(&flush->done);
+}
+
+/* stop the background gc of a file system that is ready: it is no longer
+ * submitted once fs->ready is cleared, and the work queue runs a flush item
+ * only after fs->gc_work has returned.
+ */
+static void nvs_gc_bg_stop(struct nvs_fs *fs)
+{
+	struct nvs_gc_bg_flush flush;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->ready = false;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	k_work_init(&flush.work, nvs_gc_bg_flush_work);
+	k_sem_init(&flush.done, 0, 1);
+	k_work_submit_to_queue(&nvs_gc_work_q, &flush.work);
+	k_sem_take(&flush.done, K_FOREVER);
+
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+	fs->gc_bg_done = false;
+}
+
+/* startup: the sector after the empty one is not empty while a gc done ate
+ * is in the write sector when the background gc was interrupted while
+ * erasing it. Its valid entries have been copied, so it is erased again,
+ * otherwise deleted entries could come back.
+ */
+static int nvs_gc_bg_recover(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate ate;
+	uint32_t sec_addr, addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+
+	rc = nvs_flash_cmp_const(fs, sec_addr,
+				 fs->flash_parameters->erase_value,
+				 fs->sector_size);
+	if (rc <= 0) {
 		return rc;
 	}
+
+	/* the ate's of the write sector, the close ate position excluded */
+	addr = (fs->ate_wra & ADDR_SECT_MASK) + fs->sector_size - 2 * ate_size;
+	while (addr > fs->ate_wra) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (ate.id == 0xFFFF && !ate.len && !nvs_ate_crc8_check(&ate)) {
+			return nvs_flash_erase_sector(fs, sec_addr);
+		}
+
+		addr -= ate_size;
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* fill the lookup cache by walking all ate's from newest to oldest, the
+ * first valid ate found for a cache position is the most recent one.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr, *entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+
+	addr = fs->ate_wra;
+	do {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (ate.id == 0xFFFF || nvs_ate_crc8_check(&ate)) {
+			continue;
+		}
+
+		entry = nvs_lookup_cache_entry(fs, ate.id);
+		if (*entry == NVS_LOOKUP_CACHE_NO_ADDR) {
+			*entry = ate_addr;
+		}
+	} while (addr != fs->ate_wra);
+
 	return 0;
 }
+#endif
 
 static int nvs_startup(struct nvs_fs *fs)
 {
@@ -588,6 +948,13 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	/* an interrupted gc is restarted below, with an empty cache it
+	 * walks from fs->ate_wra as usual
+	 */
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can to write.
@@ -708,6 +1075,19 @@ static int nvs_startup(struct nvs_fs *fs)
 		}
 	}
 
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	if (fs->sector_count >= 3) {
+		rc = nvs_gc_bg_recover(fs);
+		if (rc) {
+			goto end;
+		}
+	}
+#endif
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	rc = nvs_lookup_cache_rebuild(fs);
+#endif
+
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -723,6 +1103,13 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+	/* the file system has to be initialized again after this */
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	nvs_gc_bg_stop(fs);
+#else
+	fs->ready = false;
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -740,6 +1127,17 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	/* the work item and the lock of a file system that is initialized
+	 * again must not be in use.
+	 */
+	if (fs->ready) {
+		nvs_gc_bg_stop(fs);
+	}
+	k_work_init(&fs->gc_work, nvs_gc_bg_work);
+	fs->gc_bg_addr = NVS_GC_BG_IDLE;
+	fs->gc_bg_done = false;
+#endif
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_device = device_get_binding(dev_name);
@@ -787,6 +1185,10 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -825,7 +1227,15 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = *nvs_lookup_cache_entry(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		/* no valid ate of any id at this cache position */
+		goto no_prev;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (1) {
@@ -843,6 +1253,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+no_prev:
+#endif
 	if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
@@ -910,6 +1323,13 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 		gc_count++;
 	}
+
+#if defined(CONFIG_NVS_BACKGROUND_GC)
+	/* a new sector was started, prepare the next one */
+	if (gc_count) {
+		k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+	}
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -943,7 +1363,14 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+	wlk_addr = *nvs_lookup_cache_entry(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return -ENOENT;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -54,11 +54,28 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Remote end point and local port specified */
+#define NET_CONN_HASH_SPEC		(NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC)
+
+BUILD_ASSERT((CONFIG_NET_CONN_HASH_SIZE &
+	      (CONFIG_NET_CONN_HASH_SIZE - 1)) == 0,
+	     "CONFIG_NET_CONN_HASH_SIZE must be a power of two");
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* UDP and TCP connections with a specified remote end point and local
+ * port are in the hash table, all the others in the wildcard list. A
+ * unicast packet only needs to look at one bucket and at the wildcard
+ * list.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wild;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -127,11 +144,43 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	return (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+		(conn->family == AF_INET || conn->family == AF_INET6) &&
+		(conn->flags & NET_CONN_HASH_SPEC) == NET_CONN_HASH_SPEC;
+}
+
+static const void *conn_ip_addr(struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return &net_sin6(addr)->sin6_addr;
+	}
+
+	return &net_sin(addr)->sin_addr;
+}
+
+static sys_slist_t *conn_demux_list(struct net_conn *conn)
+{
+	uint32_t hash;
+
+	if (!conn_is_hashed(conn)) {
+		return &conn_wild;
+	}
+
+	hash = net_conn_hash(conn->family, conn_ip_addr(&conn->remote_addr),
+			     net_sin(&conn->remote_addr)->sin_port,
+			     net_sin(&conn->local_addr)->sin_port);
+
+	return &conn_hash[hash & (CONFIG_NET_CONN_HASH_SIZE - 1)];
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_demux_list(conn), &conn->demux_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -378,6 +427,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_demux_list(conn), &conn->demux_node);
 
 	conn_set_unused(conn);
 
@@ -457,6 +507,46 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+/* Connection with a specified remote end point the unicast packet
+ * belongs to
+ */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port,
+				       uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *conn;
+	const void *src;
+	uint32_t hash;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		src = &ip_hdr->ipv4->src;
+	} else {
+		return NULL;
+	}
+
+	hash = net_conn_hash(family, src, src_port, dst_port);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(
+		&conn_hash[hash & (CONFIG_NET_CONN_HASH_SIZE - 1)],
+		conn, demux_node) {
+		if (conn->proto == proto && conn->family == family &&
+		    net_sin(&conn->remote_addr)->sin_port == src_port &&
+		    net_sin(&conn->local_addr)->sin_port == dst_port &&
+		    conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true) &&
+		    (!(conn->flags & NET_CONN_LOCAL_ADDR_SET) ||
+		     conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false))) {
+			return conn;
+		}
+	}
+
+	return NULL;
+}
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -517,6 +607,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	int16_t best_rank = -1;
 	struct net_conn *conn;
+	sys_slist_t *list;
+	sys_snode_t *node;
 	uint16_t src_port;
 	uint16_t dst_port;
 
@@ -580,7 +672,33 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	/* Several handlers may want a multicast or broadcast packet, so
+	 * every connection is checked. Otherwise a connection to the sender
+	 * takes it, or the best match of the others.
+	 */
+	if (is_mcast_pkt || is_bcast_pkt) {
+		list = &conn_used;
+	} else {
+		list = &conn_wild;
+
+		if ((IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+		    (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP)) {
+			best_match = conn_hash_find(pkt, ip_hdr, proto,
+						    src_port, dst_port);
+			if (best_match) {
+				goto deliver;
+			}
+		}
+	}
+
+	for (node = sys_slist_peek_head(list); node;
+	     node = sys_slist_peek_next(node)) {
+		if (list == &conn_used) {
+			conn = CONTAINER_OF(node, struct net_conn, node);
+		} else {
+			conn = CONTAINER_OF(node, struct net_conn, demux_node);
+		}
+
 		/* For packet socket data, the proto is set to ETH_P_ALL but
 		 * the listener might have a specific protocol set. This is ok
 		 * and let the packet pass this check in this case.
@@ -730,6 +848,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+deliver:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -789,6 +908,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wild);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -50,6 +50,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node of a lookup table bucket or of the list of
+	 * partially specified connections.
+	 */
+	sys_snode_t demux_node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -198,6 +203,39 @@ typedef void (*net_conn_foreach_cb_t)(struct net_conn *conn, void *user_data);
  */
 void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data);
 
+/**
+ * @brief Hash the remote address and the ports of a connection.
+ *
+ * The local address is left out, as connections often leave it
+ * unspecified, e.g. the ones accepted by a listener bound to any address.
+ *
+ * @param family AF_INET or AF_INET6
+ * @param remote_addr Remote IP address (struct in_addr or in6_addr)
+ * @param remote_port Remote port in network byte order
+ * @param local_port Local port in network byte order
+ *
+ * @return Hash value, the low bits pick a lookup table bucket.
+ */
+static inline uint32_t net_conn_hash(sa_family_t family,
+				     const void *remote_addr,
+				     uint16_t remote_port,
+				     uint16_t local_port)
+{
+	const uint8_t *addr = remote_addr;
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+	uint32_t hash = ((uint32_t)local_port << 16) | remote_port;
+	size_t i;
+
+	/* The address may come from a packet header, which is unaligned */
+	for (i = 0; i < len; i += sizeof(uint32_t)) {
+		hash ^= UNALIGNED_GET((uint32_t *)(addr + i));
+		hash *= 0x9e3779b1U;
+	}
+
+	return hash ^ (hash >> 16);
+}
+
 #if defined(CONFIG_NET_NATIVE)
 void net_conn_init(void);
 #else
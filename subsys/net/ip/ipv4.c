@@ -277,6 +277,17 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		goto drop;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) &&
+	    ((hdr->offset[0] << 8 | hdr->offset[1]) &
+	     (NET_IPV4_MF | NET_IPV4_FRAGH_OFFSET_MASK))) {
+		verdict = net_ipv4_handle_fragment(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	net_pkt_acknowledge_data(pkt, &ipv4_access);
 
 	if (opts_len) {
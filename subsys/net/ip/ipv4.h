@@ -35,6 +35,11 @@
 
 #define NET_IPV4_HDR_OPTNS_MAX_LEN 40
 
+/* IPv4 fragment offset field, in host byte order */
+#define NET_IPV4_DF 0x4000  /* Don't Fragment */
+#define NET_IPV4_MF 0x2000  /* More Fragments */
+#define NET_IPV4_FRAGH_OFFSET_MASK 0x1fff
+
 /**
  * @brief Create IPv4 packet in provided net_pkt.
  *
@@ -132,4 +137,84 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+/** Store pending IPv4 fragments. These are used when doing reassembly. */
+struct net_ipv4_reassembly {
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_delayed_work timer;
+
+	/** Pointers to pending fragments, sorted by their offset */
+	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** Protocol of the fragmented packet */
+	uint8_t proto;
+};
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * The fragment is stored until the other fragments of the same packet
+ * have been received, and the reassembled packet is then fed back to
+ * the IP stack.
+ *
+ * @param pkt Network packet holding an IPv4 fragment
+ * @param hdr IPv4 header of the fragment
+ *
+ * @return NET_OK if the fragment was consumed, NET_DROP otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_handle_fragment(struct net_pkt *pkt,
+					  struct net_ipv4_hdr *hdr);
+#else
+static inline enum net_verdict net_ipv4_handle_fragment(
+					struct net_pkt *pkt,
+					struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif
+
+/**
+ * @brief Fragment an IPv4 packet that is larger than the MTU of the
+ * network interface it is sent to.
+ *
+ * Each fragment is sent separately and the original packet is released.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet fits in the MTU and must be sent as is,
+ * NET_CONTINUE if it has been fragmented and NET_DROP if it cannot be sent.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_prepare_for_send(struct net_if *iface,
+					   struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(
+						struct net_if *iface,
+						struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif
+
 #endif /* __IPV4_H */
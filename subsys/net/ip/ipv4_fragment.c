@@ -0,0 +1,468 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <random/rand32.h>
+#include "net_private.h"
+#include "ipv4.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+static void reassembly_timeout(struct k_work *work);
+static bool reassembly_init_done;
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+/* Identification of the next fragmented packet */
+static uint16_t fragment_id;
+
+/* The id and offset fields are byte arrays in struct net_ipv4_hdr */
+static inline uint16_t hdr_get_u16(const uint8_t *field)
+{
+	return ((uint16_t)field[0] << 8) | field[1];
+}
+
+static inline void hdr_set_u16(uint8_t *field, uint16_t val)
+{
+	field[0] = val >> 8;
+	field[1] = val;
+}
+
+static inline size_t fragment_hdr_len(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+}
+
+static inline size_t fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - fragment_hdr_len(pkt);
+}
+
+static void reassembly_release(struct net_ipv4_reassembly *reass)
+{
+	int i;
+
+	k_delayed_work_cancel(&reass->timer);
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (!reass->pkt[i]) {
+			continue;
+		}
+
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
+	}
+}
+
+static struct net_ipv4_reassembly *reassembly_get(struct net_ipv4_hdr *hdr)
+{
+	uint16_t id = hdr_get_u16(hdr->id);
+	int i, avail = -1;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!k_delayed_work_remaining_get(&reassembly[i].timer)) {
+			if (avail < 0) {
+				avail = i;
+			}
+
+			continue;
+		}
+
+		if (reassembly[i].id == id &&
+		    reassembly[i].proto == hdr->proto &&
+		    net_ipv4_addr_cmp(&hdr->src, &reassembly[i].src) &&
+		    net_ipv4_addr_cmp(&hdr->dst, &reassembly[i].dst)) {
+			return &reassembly[i];
+		}
+	}
+
+	if (avail < 0) {
+		return NULL;
+	}
+
+	k_delayed_work_submit(&reassembly[avail].timer,
+			      IPV4_REASSEMBLY_TIMEOUT);
+
+	net_ipaddr_copy(&reassembly[avail].src, &hdr->src);
+	net_ipaddr_copy(&reassembly[avail].dst, &hdr->dst);
+
+	reassembly[avail].id = id;
+	reassembly[avail].proto = hdr->proto;
+
+	return &reassembly[avail];
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(work, struct net_ipv4_reassembly, timer);
+
+	NET_DBG("Reassembly id 0x%x cancelled", reass->id);
+
+	reassembly_release(reass);
+}
+
+/* Return the index of the last fragment if all the fragments of the
+ * packet have been received, a negative value otherwise.
+ */
+static int fragments_complete(struct net_ipv4_reassembly *reass)
+{
+	size_t expected = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		struct net_pkt *pkt = reass->pkt[i];
+
+		if (!pkt || net_pkt_ipv4_fragment_offset(pkt) != expected) {
+			break;
+		}
+
+		expected += fragment_payload_len(pkt);
+
+		if (!net_pkt_ipv4_fragment_more(pkt)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static void reassemble_packet(struct net_ipv4_reassembly *reass, int last)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_buf *buf;
+	struct net_pkt *pkt;
+	uint16_t len, offset;
+	int i;
+
+	buf = net_buf_frag_last(reass->pkt[0]->buffer);
+
+	/* Append the payload of the following fragments to the first one */
+	for (i = 1; i <= last; i++) {
+		pkt = reass->pkt[i];
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_pull(pkt, fragment_hdr_len(pkt))) {
+			NET_ERR("Failed to pull headers");
+			reassembly_release(reass);
+			return;
+		}
+
+		buf->frags = pkt->buffer;
+		buf = net_buf_frag_last(pkt->buffer);
+
+		pkt->buffer = NULL;
+		reass->pkt[i] = NULL;
+
+		net_pkt_unref(pkt);
+	}
+
+	pkt = reass->pkt[0];
+	reass->pkt[0] = NULL;
+
+	reassembly_release(reass);
+
+	if (net_pkt_get_len(pkt) > UINT16_MAX) {
+		NET_DBG("Reassembled packet too long");
+		goto error;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		goto error;
+	}
+
+	/* Only the length and the offset change, so the header checksum
+	 * is updated rather than computed again.
+	 */
+	len = htons(net_pkt_get_len(pkt));
+	offset = htons(hdr_get_u16(hdr->offset) & NET_IPV4_DF);
+
+	hdr->chksum = net_chksum_update16(hdr->chksum, hdr->len, len);
+	hdr->chksum = net_chksum_update16(hdr->chksum,
+					  htons(hdr_get_u16(hdr->offset)),
+					  offset);
+	hdr->len = len;
+	hdr_set_u16(hdr->offset, ntohs(offset));
+
+	if (net_pkt_set_data(pkt, &ipv4_access)) {
+		goto error;
+	}
+
+	net_pkt_set_ipv4_fragment_offset(pkt, 0U);
+	net_pkt_set_ipv4_fragment_more(pkt, false);
+	net_pkt_set_ipv4_reassembled(pkt, true);
+
+	NET_DBG("New pkt %p IPv4 len is %u bytes", pkt, ntohs(len));
+
+	/* Feed the packet back to the IP stack through the RX queue, like
+	 * the IPv6 reassembly does, so that it is not passed to L2.
+	 */
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+enum net_verdict net_ipv4_handle_fragment(struct net_pkt *pkt,
+					  struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass;
+	uint16_t flags = hdr_get_u16(hdr->offset);
+	uint16_t offset;
+	int i, last;
+
+	if (!reassembly_init_done) {
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			k_delayed_work_init(&reassembly[i].timer,
+					    reassembly_timeout);
+		}
+
+		reassembly_init_done = true;
+	}
+
+	offset = (flags & NET_IPV4_FRAGH_OFFSET_MASK) * 8U;
+
+	net_pkt_set_ipv4_fragment_offset(pkt, offset);
+	net_pkt_set_ipv4_fragment_more(pkt, flags & NET_IPV4_MF);
+
+	if ((flags & NET_IPV4_MF) && (fragment_payload_len(pkt) % 8)) {
+		NET_DBG("Fragment length is not a multiple of 8");
+		return NET_DROP;
+	}
+
+	reass = reassembly_get(hdr);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		return NET_DROP;
+	}
+
+	/* The fragments might come in wrong order so keep them sorted */
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT && reass->pkt[i];
+	     i++) {
+		uint16_t pos = net_pkt_ipv4_fragment_offset(reass->pkt[i]);
+
+		if (pos == offset) {
+			NET_DBG("Duplicate fragment, offset %u", offset);
+			return NET_DROP;
+		}
+
+		if (pos > offset) {
+			break;
+		}
+	}
+
+	if (reass->pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT - 1]) {
+		/* Too many fragments, discard the whole packet */
+		NET_DBG("No slots available for 0x%x", reass->id);
+		reassembly_release(reass);
+		return NET_DROP;
+	}
+
+	memmove(&reass->pkt[i + 1], &reass->pkt[i],
+		sizeof(void *) * (CONFIG_NET_IPV4_FRAGMENT_MAX_PKT - 1 - i));
+	reass->pkt[i] = pkt;
+
+	NET_DBG("Storing pkt %p to slot %d offset %u", pkt, i, offset);
+
+	last = fragments_complete(reass);
+	if (last >= 0) {
+		reassemble_packet(reass, last);
+	}
+
+	return NET_OK;
+}
+
+static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t hdr_len,
+			      uint16_t frag_offset, uint16_t fit_len,
+			      bool final)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *frag_pkt;
+	uint16_t old_offset, old_len, old_id, offset, len;
+	int ret = -ENOBUFS;
+
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     hdr_len - NET_IPV4H_LEN + fit_len,
+					     AF_INET, 0, BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* Copy the header and the options, then the fragment payload */
+	if (net_pkt_copy(frag_pkt, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(frag_pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt, &ipv4_access);
+	if (!hdr) {
+		goto fail;
+	}
+
+	old_len = hdr->len;
+	old_id = htons(hdr_get_u16(hdr->id));
+	old_offset = htons(hdr_get_u16(hdr->offset));
+
+	len = htons(hdr_len + fit_len);
+	offset = htons((ntohs(old_offset) & NET_IPV4_DF) |
+		       (final ? 0 : NET_IPV4_MF) | (frag_offset / 8U));
+
+	hdr->len = len;
+	hdr_set_u16(hdr->id, fragment_id);
+	hdr_set_u16(hdr->offset, ntohs(offset));
+
+	/* Update the checksum of the original header for the fields that
+	 * differ instead of computing it again.
+	 */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		hdr->chksum = net_chksum_update16(hdr->chksum, old_len, len);
+		hdr->chksum = net_chksum_update16(hdr->chksum, old_id,
+						  htons(fragment_id));
+		hdr->chksum = net_chksum_update16(hdr->chksum, old_offset,
+						  offset);
+	}
+
+	if (net_pkt_set_data(frag_pkt, &ipv4_access)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, NET_IPV4H_LEN);
+	net_pkt_set_ipv4_opts_len(frag_pkt, hdr_len - NET_IPV4H_LEN);
+	net_pkt_set_ipv4_ttl(frag_pkt, net_pkt_ipv4_ttl(pkt));
+	net_pkt_set_priority(frag_pkt, net_pkt_priority(pkt));
+
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* Let this packet to be sent and hopefully it will release
+	 * the memory that can be utilized for next sent IPv4 fragment.
+	 */
+	k_yield();
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+static int send_fragmented_pkt(struct net_pkt *pkt, uint16_t mtu)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	uint16_t frag_offset = 0U;
+	uint16_t hdr_len;
+	size_t length;
+	int fit_len;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		return -ENOBUFS;
+	}
+
+	if (hdr_get_u16(hdr->offset) & NET_IPV4_DF) {
+		NET_DBG("Packet too big and DF set");
+		return -EMSGSIZE;
+	}
+
+	hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+
+	/* All the fragments but the last one carry a multiple of 8 bytes */
+	fit_len = (mtu - hdr_len) & ~7;
+	if (fit_len <= 0) {
+		return -EINVAL;
+	}
+
+	if (!fragment_id) {
+		fragment_id = sys_rand32_get();
+	}
+
+	fragment_id++;
+
+	length = net_pkt_get_len(pkt) - hdr_len;
+	while (length) {
+		bool final = false;
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		ret = send_ipv4_fragment(pkt, hdr_len, frag_offset, fit_len,
+					 final);
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_if *iface,
+					   struct net_pkt *pkt)
+{
+	uint16_t mtu = net_if_get_mtu(iface);
+	int ret;
+
+	/* A TCP packet to be segmented is not fragmented */
+	if (!mtu || net_pkt_get_len(pkt) <= mtu || net_pkt_gso_size(pkt)) {
+		return NET_OK;
+	}
+
+	ret = send_fragmented_pkt(pkt, mtu);
+	if (ret < 0) {
+		NET_DBG("Cannot fragment IPv4 pkt (%d)", ret);
+		return NET_DROP;
+	}
+
+	/* We "fake" the sending of the packet here so that
+	 * tcp.c:tcp_retry_expired() will increase the ref
+	 * count when re-sending the packet.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP)) {
+		net_pkt_set_sent(pkt, true);
+	}
+
+	/* The fragments are sent separately, release the original */
+	net_pkt_unref(pkt);
+
+	return NET_CONTINUE;
+}
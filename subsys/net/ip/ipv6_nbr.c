@@ -97,6 +97,13 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+BUILD_ASSERT((CONFIG_NET_IPV6_NBR_HASH_SIZE &
+	      (CONFIG_NET_IPV6_NBR_HASH_SIZE - 1)) == 0,
+	     "CONFIG_NET_IPV6_NBR_HASH_SIZE must be a power of two");
+
+/* The neighbors in use are hashed by their IPv6 address */
+static sys_slist_t nbr_hash[CONFIG_NET_IPV6_NBR_HASH_SIZE];
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -255,24 +262,39 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+static sys_slist_t *nbr_bucket(const struct in6_addr *addr)
+{
+	uint32_t hash = 0U;
+	int i;
+
+	/* The address may come from a packet header, which is unaligned */
+	for (i = 0; i < ARRAY_SIZE(addr->s6_addr32); i++) {
+		hash ^= UNALIGNED_GET(&addr->s6_addr32[i]);
+		hash *= 0x9e3779b1U;
+	}
+
+	hash ^= hash >> 16;
+
+	return &nbr_hash[hash & (CONFIG_NET_IPV6_NBR_HASH_SIZE - 1)];
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	struct net_ipv6_nbr_data *data;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	ARG_UNUSED(table);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	SYS_SLIST_FOR_EACH_CONTAINER(nbr_bucket(addr), data, node) {
+		struct net_nbr *nbr = CONTAINER_OF((uint8_t *)data,
+						   struct net_nbr, __nbr);
 
 		if (iface && nbr->iface != iface) {
 			continue;
 		}
 
-		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+		if (net_ipv6_addr_cmp(&data->addr, addr)) {
 			return nbr;
 		}
 	}
@@ -431,6 +453,8 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 
 	nbr_init(nbr, iface, addr, is_router, state);
 
+	sys_slist_prepend(nbr_bucket(addr), &net_ipv6_nbr_data(nbr)->node);
+
 	NET_DBG("nbr %p iface %p/%d state %d IPv6 %s",
 		nbr, iface, net_if_get_by_iface(iface), state,
 		log_strdup(net_sprint_ipv6_addr(addr)));
@@ -653,7 +677,8 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	sys_slist_find_and_remove(nbr_bucket(&net_ipv6_nbr_data(nbr)->addr),
+				  &net_ipv6_nbr_data(nbr)->node);
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -787,9 +812,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A TCP
+	 * packet to be segmented is not fragmented either.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_gso_size(pkt)) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -910,6 +936,8 @@ try_send:
 	if (nbr && nbr->idx != NET_NBR_LLADDR_UNKNOWN) {
 		struct net_linkaddr_storage *lladdr;
 
+		net_stats_update_ipv6_nbr_hit(net_pkt_iface(pkt));
+
 		lladdr = net_nbr_get_lladdr(nbr->idx);
 
 		net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
@@ -933,6 +961,8 @@ try_send:
 		return NET_OK;
 	}
 
+	net_stats_update_ipv6_nbr_miss(net_pkt_iface(pkt));
+
 #if defined(CONFIG_NET_IPV6_ND)
 	/* We need to send NS and wait for NA before sending the packet. */
 	ret = net_ipv6_send_ns(net_pkt_iface(pkt), pkt,
@@ -159,6 +159,47 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update a checksum after a 16-bit field it covers has changed
+ *
+ * Follows equation 3 of RFC 1624, so a checksum that was valid before
+ * stays valid without adding up the whole packet again.
+ *
+ * @param chksum Checksum field value, in network byte order
+ * @param old_val Previous value of the field, in network byte order
+ * @param new_val New value of the field, in network byte order
+ *
+ * @return New checksum field value, in network byte order
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m') */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+/**
+ * @brief Update a checksum after a 32-bit field it covers has changed
+ *
+ * @param chksum Checksum field value, in network byte order
+ * @param old_val Previous value of the field, in network byte order
+ * @param new_val New value of the field, in network byte order
+ *
+ * @return New checksum field value, in network byte order
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update16(chksum, old_val, new_val);
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -238,6 +238,8 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
+	EC(ETHERNET_HW_LRO,               "Large receive offload"),
 	EC(ETHERNET_AUTO_NEGOTIATION_SET, "Auto negotiation"),
 	EC(ETHERNET_LINK_10BASE_T,        "10 Mbits"),
 	EC(ETHERNET_LINK_100BASE_T,       "100 Mbits"),
@@ -1073,6 +1075,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 #endif /* CONFIG_NET_STATISTICS_MLD */
 #endif /* CONFIG_NET_STATISTICS_IPV6 */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_NBR) && defined(CONFIG_NET_NATIVE_IPV6)
+	PR("IPv6 nbr hit   %d\tmiss\t%d\n",
+	   GET_STAT(iface, ipv6_nbr.hit),
+	   GET_STAT(iface, ipv6_nbr.miss));
+#endif /* CONFIG_NET_STATISTICS_IPV6_NBR */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4) && defined(CONFIG_NET_NATIVE_IPV4)
 	PR("IPv4 recv      %d\tsent\t%d\tdrop\t%d\tforwarded\t%d\n",
 	   GET_STAT(iface, ipv4.recv),
@@ -1081,6 +1089,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv4.forwarded));
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
+#if defined(CONFIG_NET_STATISTICS_ARP) && defined(CONFIG_NET_NATIVE_IPV4)
+	PR("ARP hit        %d\tmiss\t%d\n",
+	   GET_STAT(iface, arp.hit),
+	   GET_STAT(iface, arp.miss));
+#endif /* CONFIG_NET_STATISTICS_ARP */
+
 	PR("IP vhlerr      %d\thblener\t%d\tlblener\t%d\n",
 	   GET_STAT(iface, ip_errors.vhlerr),
 	   GET_STAT(iface, ip_errors.hblenerr),
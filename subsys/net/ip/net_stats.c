@@ -99,6 +99,12 @@ static inline void stats(struct net_if *iface)
 #endif /* CONFIG_NET_STATISTICS_MLD */
 #endif /* CONFIG_NET_STATISTICS_IPV6 */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_NBR)
+		NET_INFO("IPv6 nbr hit   %d\tmiss\t%d",
+			 GET_STAT(iface, ipv6_nbr.hit),
+			 GET_STAT(iface, ipv6_nbr.miss));
+#endif /* CONFIG_NET_STATISTICS_IPV6_NBR */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4)
 		NET_INFO("IPv4 recv      %d\tsent\t%d\tdrop\t%d\tforwarded\t%d",
 			 GET_STAT(iface, ipv4.recv),
@@ -107,6 +113,12 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv4.forwarded));
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
+#if defined(CONFIG_NET_STATISTICS_ARP)
+		NET_INFO("ARP hit        %d\tmiss\t%d",
+			 GET_STAT(iface, arp.hit),
+			 GET_STAT(iface, arp.miss));
+#endif /* CONFIG_NET_STATISTICS_ARP */
+
 		NET_INFO("IP vhlerr      %d\thblener\t%d\tlblener\t%d",
 			 GET_STAT(iface, ip_errors.vhlerr),
 			 GET_STAT(iface, ip_errors.hblenerr),
@@ -113,6 +113,23 @@ static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 #define net_stats_update_ipv6_nd_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_NBR) && defined(CONFIG_NET_NATIVE_IPV6)
+/* IPv6 neighbor cache stats */
+
+static inline void net_stats_update_ipv6_nbr_hit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nbr.hit++);
+}
+
+static inline void net_stats_update_ipv6_nbr_miss(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv6_nbr.miss++);
+}
+#else
+#define net_stats_update_ipv6_nbr_hit(iface)
+#define net_stats_update_ipv6_nbr_miss(iface)
+#endif /* CONFIG_NET_STATISTICS_IPV6_NBR */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4) && defined(CONFIG_NET_NATIVE_IPV4)
 /* IPv4 stats */
 
@@ -136,6 +153,23 @@ static inline void net_stats_update_ipv4_recv(struct net_if *iface)
 #define net_stats_update_ipv4_recv(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
+#if defined(CONFIG_NET_STATISTICS_ARP) && defined(CONFIG_NET_NATIVE_IPV4)
+/* ARP cache stats */
+
+static inline void net_stats_update_arp_hit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.arp.hit++);
+}
+
+static inline void net_stats_update_arp_miss(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.arp.miss++);
+}
+#else
+#define net_stats_update_arp_hit(iface)
+#define net_stats_update_arp_miss(iface)
+#endif /* CONFIG_NET_STATISTICS_ARP */
+
 #if defined(CONFIG_NET_STATISTICS_ICMP) && defined(CONFIG_NET_NATIVE_IPV4)
 /* Common ICMPv4/ICMPv6 stats */
 static inline void net_stats_update_icmp_sent(struct net_if *iface)
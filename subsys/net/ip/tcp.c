@@ -932,7 +932,7 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
 	struct net_context *ctx = net_pkt_context(pkt);
 	struct net_tcp_hdr *tcp_hdr;
-	bool calc_chksum = false;
+	uint16_t chksum;
 	int ret;
 
 	if (!ctx || !ctx->tcp) {
@@ -955,10 +955,19 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 		return -EMSGSIZE;
 	}
 
+	/* The header was finalized already, so the checksum only needs to
+	 * account for the fields changed below, RFC 1624.
+	 */
+	chksum = tcp_hdr->chksum;
+
 	if (sys_get_be32(tcp_hdr->ack) != ctx->tcp->send_ack) {
-		sys_put_be32(ctx->tcp->send_ack, tcp_hdr->ack);
-		tcp_hdr->chksum = 0U;
-		calc_chksum = true;
+		uint32_t ack = htonl(ctx->tcp->send_ack);
+
+		chksum = net_chksum_update32(chksum,
+					     UNALIGNED_GET((uint32_t *)
+							   tcp_hdr->ack),
+					     ack);
+		UNALIGNED_PUT(ack, (uint32_t *)tcp_hdr->ack);
 	}
 
 	/* The data stream code always sets this flag, because
@@ -968,26 +977,23 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 	 */
 	if (ctx->tcp->sent_ack != ctx->tcp->send_ack &&
 		(tcp_hdr->flags & NET_TCP_ACK) == 0U) {
+		uint16_t word = UNALIGNED_GET((uint16_t *)&tcp_hdr->offset);
+
 		tcp_hdr->flags |= NET_TCP_ACK;
-		tcp_hdr->chksum = 0U;
-		calc_chksum = true;
+		chksum = net_chksum_update16(chksum, word,
+					     UNALIGNED_GET((uint16_t *)
+							   &tcp_hdr->offset));
+	}
+
+	/* A checksum left to the hardware stays zero */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		tcp_hdr->chksum = chksum;
 	}
 
 	/* As we modified the header, we need to write it back.
 	 */
 	net_pkt_set_data(pkt, &tcp_access);
 
-	if (calc_chksum) {
-		net_pkt_cursor_init(pkt);
-		net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
-			     net_pkt_ip_opts_len(pkt));
-
-		/* No need to get tcp_hdr again */
-		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
-
-		net_pkt_set_data(pkt, &tcp_access);
-	}
-
 	if (tcp_hdr->flags & NET_TCP_FIN) {
 		ctx->tcp->fin_sent = 1U;
 	}
@@ -24,17 +24,23 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
+#define RTO_MAX_MS (60 * MSEC_PER_SEC)
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
-static int tcp_window = NET_IPV6_MTU;
+static int tcp_window = CONFIG_NET_TCP_RECV_WINDOW_SIZE;
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
+/* Connections with known end points, hashed like in connection.c */
+static sys_slist_t tcp_conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+
 static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
+static void tcp_ooo_flush(struct tcp *conn);
+static void tcp_conn_hash_remove(struct tcp *conn);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -337,14 +343,17 @@ static int tcp_conn_unref(struct tcp *conn)
 	net_context_unref(conn->context);
 
 	tcp_send_queue_flush(conn);
+	tcp_ooo_flush(conn);
 
 	k_delayed_work_cancel(&conn->send_data_timer);
 	tcp_pkt_unref(conn->send_data);
 
 	k_delayed_work_cancel(&conn->timewait_timer);
 	k_delayed_work_cancel(&conn->fin_timer);
+	k_delayed_work_cancel(&conn->ack_timer);
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
+	tcp_conn_hash_remove(conn);
 
 	memset(conn, 0, sizeof(*conn));
 
@@ -416,7 +425,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 	}
 
 	if (conn->in_retransmission) {
-		k_delayed_work_submit(&conn->send_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_timer, K_MSEC(conn->rto));
 	}
 
 out:
@@ -460,7 +469,7 @@ static void tcp_send_timer_cancel(struct tcp *conn)
 		conn->in_retransmission = false;
 	} else {
 		conn->send_retries = tcp_retries;
-		k_delayed_work_submit(&conn->send_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_timer, K_MSEC(conn->rto));
 	}
 }
 
@@ -527,12 +536,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
 	uint8_t opt, opt_len;
+	int i;
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -575,9 +582,35 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm = true;
+			break;
+		case TCPOPT_SACK:
+			if ((opt_len - 2) % 8) {
+				result = false;
+				goto end;
+			}
+
+			for (i = 0; i < TCP_SACK_MAX_BLOCKS &&
+				    i < (opt_len - 2) / 8; i++) {
+				uint8_t *edges = &options[2 + i * 8];
+
+				recv_options->sack[i].left =
+					sys_get_be32(edges);
+				recv_options->sack[i].right =
+					sys_get_be32(edges + 4);
+			}
+
+			recv_options->num_sack = i;
+			break;
 		default:
 			continue;
 		}
@@ -590,6 +623,22 @@ end:
 	return result;
 }
 
+/* Copy of the packet positioned at its len bytes of payload */
+static struct net_pkt *tcp_data_clone(struct net_pkt *pkt, size_t len,
+				      k_timeout_t timeout)
+{
+	struct net_pkt *up = net_pkt_clone(pkt, timeout);
+
+	if (up) {
+		net_pkt_cursor_init(up);
+		net_pkt_set_overwrite(up, true);
+
+		net_pkt_skip(up, net_pkt_get_len(up) - len);
+	}
+
+	return up;
+}
+
 static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 {
 	int len = tcp_data_len(pkt);
@@ -602,18 +651,13 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 	if (len > 0) {
 		if (conn->context->recv_cb) {
 			struct net_pkt *up =
-				net_pkt_clone(pkt, TCP_PKT_ALLOC_TIMEOUT);
+				tcp_data_clone(pkt, len, TCP_PKT_ALLOC_TIMEOUT);
 
 			if (!up) {
 				len = -ENOBUFS;
 				goto out;
 			}
 
-			net_pkt_cursor_init(up);
-			net_pkt_set_overwrite(up, true);
-
-			net_pkt_skip(up, net_pkt_get_len(up) - len);
-
 			/* Do not pass data to application with TCP conn
 			 * locked as there could be an issue when the app tries
 			 * to send the data and the conn is locked. So the recv
@@ -627,6 +671,202 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 	return len;
 }
 
+/* Data received after a gap is held in payload clones of the segments,
+ * sorted by sequence number which is kept in the user data of their first
+ * buffer.
+ */
+static uint32_t tcp_ooo_seq(struct net_pkt *up)
+{
+	return UNALIGNED_GET((uint32_t *)net_buf_user_data(up->buffer));
+}
+
+static void tcp_ooo_flush(struct tcp *conn)
+{
+	struct net_pkt *up;
+
+	while ((up = tcp_slist(&conn->ooo_queue, get, struct net_pkt, next))) {
+		net_pkt_unref(up);
+	}
+
+	conn->ooo_len = 0;
+}
+
+static void tcp_ooo_add(struct tcp *conn, struct net_pkt *pkt, uint32_t seq,
+			size_t len)
+{
+	struct net_pkt *prev = NULL, *up;
+
+	if (tcp_recv_cb || !conn->context->recv_cb ||
+	    conn->ooo_len + len > CONFIG_NET_TCP_OUT_OF_ORDER_QUEUE_SIZE) {
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo_queue, up, next) {
+		if (net_tcp_seq_greater(tcp_ooo_seq(up), seq)) {
+			break;
+		}
+
+		prev = up;
+	}
+
+	/* Held already, the peer has resent it */
+	if (prev && !net_tcp_seq_greater(seq + len, tcp_ooo_seq(prev) +
+					 net_pkt_remaining_data(prev))) {
+		return;
+	}
+
+	/* Better lose the segment than wait for a buffer */
+	up = tcp_data_clone(pkt, len, K_NO_WAIT);
+	if (!up) {
+		return;
+	}
+
+	UNALIGNED_PUT(seq, (uint32_t *)net_buf_user_data(up->buffer));
+
+	sys_slist_insert(&conn->ooo_queue, prev ? &prev->next : NULL,
+			 &up->next);
+	conn->ooo_len += len;
+	conn->ooo_last = seq;
+
+	NET_DBG("conn: %p seq=%u len=%zu held=%zu", conn, seq, len,
+		conn->ooo_len);
+}
+
+/* Pass the held data that follows conn->ack to the application */
+static void tcp_ooo_deliver(struct tcp *conn)
+{
+	struct net_pkt *up;
+
+	while ((up = tcp_slist(&conn->ooo_queue, peek_head, struct net_pkt,
+			       next))) {
+		uint32_t seq = tcp_ooo_seq(up);
+		size_t len = net_pkt_remaining_data(up);
+
+		if (net_tcp_seq_greater(seq, conn->ack)) {
+			break;
+		}
+
+		(void)sys_slist_get(&conn->ooo_queue);
+		conn->ooo_len -= len;
+
+		if (!net_tcp_seq_greater(seq + len, conn->ack)) {
+			net_pkt_unref(up);
+			continue;
+		}
+
+		net_pkt_skip(up, conn->ack - seq);
+		conn_ack(conn, + (seq + len - conn->ack));
+
+		k_fifo_put(&conn->recv_data, up);
+	}
+}
+
+static int tcp_sack_block_add(struct tcp *conn, struct tcp_sack_block *blocks,
+			      int n, bool *latest, struct tcp_sack_block *b)
+{
+	if (!*latest && !net_tcp_seq_greater(b->left, conn->ooo_last) &&
+	    net_tcp_seq_greater(b->right, conn->ooo_last)) {
+		blocks[0] = *b;
+		*latest = true;
+	} else if (n < TCP_SACK_MAX_BLOCKS) {
+		blocks[n++] = *b;
+	}
+
+	return n;
+}
+
+/* The held data as SACK blocks, the one with the latest segment first,
+ * RFC 2018 chapter 4.
+ */
+static int tcp_sack_blocks(struct tcp *conn, struct tcp_sack_block *blocks)
+{
+	struct tcp_sack_block cur = { 0 };
+	bool started = false, latest = false;
+	struct net_pkt *up;
+	int n = 1; /* blocks[0] is kept for the latest one */
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo_queue, up, next) {
+		uint32_t left = tcp_ooo_seq(up);
+		uint32_t right = left + net_pkt_remaining_data(up);
+
+		if (started && !net_tcp_seq_greater(left, cur.right)) {
+			if (net_tcp_seq_greater(right, cur.right)) {
+				cur.right = right;
+			}
+			continue;
+		}
+
+		if (started) {
+			n = tcp_sack_block_add(conn, blocks, n, &latest, &cur);
+		}
+
+		cur.left = left;
+		cur.right = right;
+		started = true;
+	}
+
+	if (started) {
+		n = tcp_sack_block_add(conn, blocks, n, &latest, &cur);
+	}
+
+	if (!latest) {
+		memmove(&blocks[0], &blocks[1], --n * sizeof(blocks[0]));
+	}
+
+	return n;
+}
+
+/* Options of an outgoing segment, padded to a multiple of 4 bytes */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	struct tcp_sack_block blocks[TCP_SACK_MAX_BLOCKS];
+	size_t len = 0;
+	int i, n;
+
+	if (flags & SYN) {
+		/* SYN-ACK only agrees to what the peer proposed */
+		bool syn_ack = flags & ACK;
+
+		if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		    (!syn_ack || conn->recv_options.wnd_found)) {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_WINDOW;
+			buf[len++] = 3;
+			buf[len++] = conn->rcv_wscale;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    (!syn_ack || conn->recv_options.sack_perm)) {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_SACK_PERM;
+			buf[len++] = 2;
+		}
+		goto out;
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) || !conn->sack_ok ||
+	    !(flags & ACK) || sys_slist_is_empty(&conn->ooo_queue)) {
+		goto out;
+	}
+
+	n = tcp_sack_blocks(conn, blocks);
+
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_SACK;
+	buf[len++] = 2 + n * sizeof(struct tcp_sack_block);
+
+	for (i = 0; i < n; i++) {
+		UNALIGNED_PUT(htonl(blocks[i].left), (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+		UNALIGNED_PUT(htonl(blocks[i].right), (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+	}
+ out:
+	return len;
+}
+
 static int tcp_finalize_pkt(struct net_pkt *pkt)
 {
 	net_pkt_cursor_init(pkt);
@@ -643,10 +883,12 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, uint8_t *options, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	uint32_t win;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -658,16 +900,24 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 	th->th_sport = conn->src.sin.sin_port;
 	th->th_dport = conn->dst.sin.sin_port;
 
-	th->th_off = 5;
+	th->th_off = 5 + options_len / 4;
 	th->th_flags = flags;
-	th->th_win = htons(conn->recv_win);
+	/* The window of a SYN segment is never scaled, RFC 7323 */
+	win = (flags & SYN) ? conn->recv_win :
+		conn->recv_win >> conn->rcv_wscale;
+	th->th_win = htons(MIN(win, UINT16_MAX));
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
 		th->th_ack = htonl(conn->ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0 || !options_len) {
+		return ret;
+	}
+
+	return net_pkt_write(pkt, options, options_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -690,16 +940,28 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t options[40]; /* TCP header max options size is 40 */
+	size_t options_len = 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	/* Data segments are sized for a bare header */
+	if (!data) {
+		options_len = tcp_options_build(conn, flags, options);
+	}
+
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
 	if (data) {
+		/* More than a segment is split at the link layer */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -711,7 +973,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -725,6 +987,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 
 	NET_DBG("%s", log_strdup(tcp_th(pkt)));
 
+	/* The segment acknowledges all the data received so far */
+	if ((flags & ACK) && conn->ack_pending) {
+		k_delayed_work_cancel(&conn->ack_timer);
+		conn->ack_pending = false;
+	}
+
 	if (tcp_send_cb) {
 		ret = tcp_send_cb(pkt);
 		goto out;
@@ -744,6 +1012,72 @@ static void tcp_out(struct tcp *conn, uint8_t flags)
 	(void)tcp_out_ext(conn, flags, NULL /* no data */, conn->seq);
 }
 
+/* Acknowledge in-sequence data, possibly later, RFC 1122 4.2.3.2 */
+static void tcp_out_data_ack(struct tcp *conn)
+{
+	if (CONFIG_NET_TCP_ACK_DELAY == 0 || conn->ack_pending) {
+		tcp_out(conn, ACK);
+		return;
+	}
+
+	conn->ack_pending = true;
+	k_delayed_work_submit(&conn->ack_timer,
+			      K_MSEC(CONFIG_NET_TCP_ACK_DELAY));
+}
+
+static void tcp_ack_timeout(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, ack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending) {
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+
+/* Receive window of a new connection and the shift it is advertised
+ * with, RFC 7323
+ */
+static void tcp_recv_win_init(struct tcp *conn)
+{
+	uint32_t win = tcp_window;
+
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	if (conn->context->options.rcvbuf > 0) {
+		win = conn->context->options.rcvbuf;
+	}
+#endif
+
+	conn->rcv_wscale = 0U;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		while ((win >> conn->rcv_wscale) > UINT16_MAX &&
+		       conn->rcv_wscale < TCP_WSCALE_MAX) {
+			conn->rcv_wscale++;
+		}
+	}
+
+	conn->recv_win = MIN(win, (uint32_t)UINT16_MAX << conn->rcv_wscale);
+}
+
+/* Windows are only scaled if both SYN segments carried the option */
+static void tcp_wscale_agree(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    conn->recv_options.wnd_found) {
+		conn->snd_wscale = MIN(conn->recv_options.window,
+				       TCP_WSCALE_MAX);
+		return;
+	}
+
+	conn->snd_wscale = 0U;
+	conn->rcv_wscale = 0U;
+	conn->recv_win = MIN(conn->recv_win, UINT16_MAX);
+}
+
 static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 {
 	int total = net_pkt_get_len(pkt);
@@ -776,9 +1110,21 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+	return MIN(conn->send_win, conn->cwnd);
+}
+#else
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+	return conn->send_win;
+}
+#endif
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < (int)tcp_send_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -803,16 +1149,59 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Round-trip time measurement and retransmission timeout, RFC 6298 */
+static void tcp_rto_set(struct tcp *conn, uint32_t rto)
 {
-	int ret = 0;
-	int pos, len;
-	struct net_pkt *pkt;
+	conn->rto = MIN(MAX(rto, CONFIG_NET_TCP_MIN_RETRANSMISSION_TIMEOUT),
+			RTO_MAX_MS);
+}
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq, int len)
+{
+	/* Only one segment is timed at a time, and never a retransmitted
+	 * one (Karn's algorithm).
+	 */
+	if (conn->rtt_pending || net_tcp_seq_cmp(seq, conn->send_max) < 0) {
+		return;
+	}
+
+	conn->rtt_seq = seq + len;
+	conn->rtt_start = k_uptime_get_32();
+	conn->rtt_pending = true;
+}
+
+static void tcp_rtt_update(struct tcp *conn, uint32_t ack)
+{
+	int32_t rtt, delta;
+
+	if (!conn->rtt_pending || net_tcp_seq_cmp(ack, conn->rtt_seq) < 0) {
+		return;
+	}
+
+	conn->rtt_pending = false;
+	rtt = k_uptime_get_32() - conn->rtt_start;
+
+	if (!conn->rtt_measured) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+		conn->rtt_measured = true;
+	} else {
+		delta = rtt - (conn->srtt >> 3);
+		conn->srtt += delta;
+		conn->rttvar += abs(delta) - (conn->rttvar >> 2);
+	}
+
+	tcp_rto_set(conn, (conn->srtt >> 3) +
+		    MAX(k_ticks_to_ms_ceil32(1), conn->rttvar));
+
+	NET_DBG("conn: %p rtt=%d srtt=%d rttvar=%d rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+static int tcp_send_segment(struct tcp *conn, int pos, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
@@ -828,20 +1217,276 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
-	}
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
 
 	/* The data we want to send, has been moved to the send queue so we
 	 * can unref the head net_pkt. If there was an error, we need to remove
 	 * the packet anyway.
 	 */
 	tcp_pkt_unref(pkt);
+ out:
+	return ret;
+}
+
+/* Congestion control, RFC 5681 and RFC 6582 (NewReno) */
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+static void tcp_ca_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cwnd = MIN(4 * mss, MAX(2 * mss, 4380));
+	conn->ssthresh = UINT32_MAX;
+	conn->recover = conn->seq - 1;
+	conn->sack_high = conn->seq;
+	conn->rexmit_next = conn->seq;
+	conn->dup_acks = 0U;
+	conn->in_recovery = false;
+}
+
+static void tcp_ca_retransmit(struct tcp *conn)
+{
+	uint32_t len = MIN(conn->unacked_len, conn_mss(conn));
+
+	conn->rtt_pending = false;
+
+	if (len > 0) {
+		(void)tcp_send_segment(conn, 0, len);
+		conn->rexmit_next = conn->seq + len;
+	}
+}
+
+/* Blocks of the last segment outside of the data in flight are ignored */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	int i;
+
+	for (i = 0; i < opts->num_sack; i++) {
+		struct tcp_sack_block *b = &opts->sack[i];
+
+		if (!net_tcp_seq_greater(b->left, conn->seq) ||
+		    !net_tcp_seq_greater(b->right, b->left) ||
+		    net_tcp_seq_greater(b->right, conn->send_max)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(b->right, conn->sack_high)) {
+			conn->sack_high = b->right;
+		}
+	}
+}
+
+/* Resend the start of the first hole below the highest SACKed data which
+ * was not resent during this recovery yet. Only the blocks of the last
+ * segment are known, the peer reports the most recent ones.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t start = conn->seq, end = conn->sack_high;
+	bool moved;
+	int i;
+
+	if (!conn->sack_ok || opts->num_sack == 0U) {
+		return false;
+	}
+
+	if (net_tcp_seq_greater(conn->rexmit_next, start)) {
+		start = conn->rexmit_next;
+	}
+
+	if (net_tcp_seq_greater(end, conn->seq + conn->unacked_len)) {
+		end = conn->seq + conn->unacked_len;
+	}
+
+	do {
+		moved = false;
+		for (i = 0; i < opts->num_sack; i++) {
+			struct tcp_sack_block *b = &opts->sack[i];
+
+			if (!net_tcp_seq_greater(b->left, start) &&
+			    net_tcp_seq_greater(b->right, start)) {
+				start = b->right;
+				moved = true;
+			}
+		}
+	} while (moved);
+
+	if (!net_tcp_seq_greater(end, start)) {
+		return false;
+	}
+
+	for (i = 0; i < opts->num_sack; i++) {
+		struct tcp_sack_block *b = &opts->sack[i];
+
+		if (net_tcp_seq_greater(b->left, start) &&
+		    net_tcp_seq_greater(end, b->left)) {
+			end = b->left;
+		}
+	}
+
+	NET_DBG("conn: %p resend hole %u-%u", conn, start, end);
+
+	conn->rtt_pending = false;
+	conn->rexmit_next = start + MIN(end - start, conn_mss(conn));
+	(void)tcp_send_segment(conn, start - conn->seq,
+			       conn->rexmit_next - start);
+
+	return true;
+}
+
+static void tcp_ca_ack(struct tcp *conn, uint32_t len_acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->dup_acks = 0U;
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_greater(conn->seq, conn->recover)) {
+			/* Full ACK, everything sent before the loss */
+			conn->cwnd = MAX((uint32_t)conn->unacked_len, mss);
+			conn->cwnd = MIN(conn->ssthresh, conn->cwnd + mss);
+			conn->in_recovery = false;
+			return;
+		}
+
+		/* Partial ACK, the next segment was lost too */
+		tcp_sack_update(conn);
+		if (!tcp_sack_retransmit(conn)) {
+			tcp_ca_retransmit(conn);
+		}
+		conn->cwnd -= MIN(conn->cwnd, len_acked);
+		if (len_acked >= mss) {
+			conn->cwnd += mss;
+		}
+		return;
+	}
+
+	/* Growing past what the peer accepts would only allow a burst
+	 * once it opens its window.
+	 */
+	if (conn->cwnd >= conn->send_win) {
+		return;
+	}
+
+	if (conn->cwnd < conn->ssthresh) {
+		conn->cwnd += MIN(len_acked, mss);
+	} else {
+		conn->cwnd += MAX(1, mss * mss / conn->cwnd);
+	}
+}
+
+static void tcp_ca_dup_ack(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	tcp_sack_update(conn);
+
+	if (conn->in_recovery) {
+		/* A resent hole takes the place of new data */
+		if (!tcp_sack_retransmit(conn)) {
+			conn->cwnd += mss;
+		}
+		return;
+	}
+
+	if (++conn->dup_acks < 3) {
+		return;
+	}
+
+	/* Duplicates of an ACK sent before the last loss do not start
+	 * another recovery.
+	 */
+	if (!net_tcp_seq_greater(conn->seq, conn->recover)) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit", conn);
+
+	conn->ssthresh = MAX((uint32_t)conn->unacked_len / 2, 2 * mss);
+	conn->recover = conn->send_max - 1;
+	conn->in_recovery = true;
+
+	tcp_ca_retransmit(conn);
+	conn->cwnd = conn->ssthresh + 3 * mss;
+}
+
+static void tcp_ca_timeout(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	/* Only the first timeout of a segment halves the threshold */
+	if (conn->send_data_retries == 0U) {
+		conn->ssthresh = MAX((uint32_t)conn->unacked_len / 2, 2 * mss);
+	}
+
+	conn->cwnd = mss;
+	conn->recover = conn->send_max - 1;
+	/* The peer may drop what it reported, RFC 2018 chapter 8 */
+	conn->sack_high = conn->seq;
+	conn->rexmit_next = conn->seq;
+	conn->dup_acks = 0U;
+	conn->in_recovery = false;
+}
+#else
+static void tcp_ca_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void tcp_ca_ack(struct tcp *conn, uint32_t len_acked)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(len_acked);
+}
+
+static void tcp_ca_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void tcp_ca_timeout(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
+/* Most data sent in one packet, several segments with NET_TCP_GSO */
+static uint32_t tcp_send_max(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (conn->iface &&
+	    net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    mss < CONFIG_NET_TCP_GSO_MAX_SIZE) {
+		return CONFIG_NET_TCP_GSO_MAX_SIZE / mss * mss;
+	}
+#endif
+
+	return mss;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	uint32_t seq = conn->seq + conn->unacked_len;
+	int ret, len;
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   tcp_send_max(conn));
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
+	if (ret == 0) {
+		tcp_rtt_start(conn, seq, len);
+		if (net_tcp_seq_greater(seq + len, conn->send_max)) {
+			conn->send_max = seq + len;
+		}
+		conn->unacked_len += len;
+	}
 
 	conn_send_data_dump(conn);
 
- out:
 	return ret;
 }
 
@@ -887,7 +1532,8 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_data_timer,
+				      K_MSEC(conn->rto));
 	}
  out:
 	return ret;
@@ -909,6 +1555,9 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_ca_timeout(conn);
+	conn->rtt_pending = false;
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -934,7 +1583,9 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
-	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+	/* Back off the timer until an ACK brings a new RTT sample */
+	tcp_rto_set(conn, conn->rto * 2);
+	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn->rto));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -993,13 +1644,17 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->seq = (IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
+	conn->send_max = conn->seq;
+	conn->rto = tcp_rto;
 
 	sys_slist_init(&conn->send_queue);
+	sys_slist_init(&conn->ooo_queue);
 
 	k_delayed_work_init(&conn->send_timer, tcp_send_process);
 
 	k_delayed_work_init(&conn->timewait_timer, tcp_timewait_timeout);
 	k_delayed_work_init(&conn->fin_timer, tcp_fin_timeout);
+	k_delayed_work_init(&conn->ack_timer, tcp_ack_timeout);
 
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	k_delayed_work_init(&conn->send_data_timer, tcp_resend_data);
@@ -1036,39 +1691,63 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static bool tcp_endpoint_cmp(union tcp_endpoint *ep1, union tcp_endpoint *ep2)
 {
-	union tcp_endpoint ep_tmp;
+	return !memcmp(ep1, ep2, tcp_endpoint_len(ep1->sa.sa_family));
+}
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+static sys_slist_t *tcp_conn_hash_list(union tcp_endpoint *src,
+				       union tcp_endpoint *dst)
+{
+	const void *addr = &dst->sin.sin_addr;
+	uint32_t hash;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && dst->sa.sa_family == AF_INET6) {
+		addr = &dst->sin6.sin6_addr;
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
+	hash = net_conn_hash(dst->sa.sa_family, addr, dst->sin.sin_port,
+			     src->sin.sin_port);
+
+	return &tcp_conn_hash[hash & (CONFIG_NET_CONN_HASH_SIZE - 1)];
+}
+
+/* Make the connection found by its current end points */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	tcp_conn_hash_remove(conn);
+
+	conn->hash_list = tcp_conn_hash_list(&conn->src, &conn->dst);
+	sys_slist_append(conn->hash_list, &conn->hash_node);
 }
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
+static void tcp_conn_hash_remove(struct tcp *conn)
 {
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	if (conn->hash_list) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
 }
 
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	bool found = false;
+	union tcp_endpoint src, dst;
 	struct tcp *conn;
-	struct tcp *tmp;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
 
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
-			break;
+	SYS_SLIST_FOR_EACH_CONTAINER(tcp_conn_hash_list(&src, &dst), conn,
+				     hash_node) {
+		if (tcp_endpoint_cmp(&conn->src, &src) &&
+		    tcp_endpoint_cmp(&conn->dst, &dst)) {
+			return conn;
 		}
 	}
 
-	return found ? conn : NULL;
+	return NULL;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -1103,6 +1782,16 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
+		/* Buffer sizes are inherited from the listening socket */
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+		conn->context->options.rcvbuf =
+			conn_old->context->options.rcvbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		conn->context->options.sndbuf =
+			conn_old->context->options.sndbuf;
+#endif
+
 		conn->accepted_conn = conn_old;
 	}
  in:
@@ -1147,6 +1836,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -1216,6 +1907,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint32_t send_win;
 	size_t len;
 	int ret;
 
@@ -1234,6 +1926,8 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	conn->recv_options.num_sack = 0U;
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -1242,10 +1936,14 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	send_win = conn->send_win;
+
 	if (th) {
 		size_t max_win;
 
-		conn->send_win = ntohs(th->th_win);
+		/* The window of a SYN segment is never scaled */
+		conn->send_win = (uint32_t)ntohs(th->th_win) <<
+			((th->th_flags & SYN) ? 0 : conn->snd_wscale);
 
 #if IS_ENABLED(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
@@ -1279,10 +1977,15 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+				conn->recv_options.sack_perm;
+			tcp_recv_win_init(conn);
+			tcp_wscale_agree(conn);
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 		} else {
+			tcp_recv_win_init(conn);
 			tcp_out(conn, SYN);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_SENT;
@@ -1292,6 +1995,7 @@ next_state:
 		if (FL(&fl, &, ACK, th_ack(th) == conn->seq &&
 				th_seq(th) == conn->ack)) {
 			tcp_send_timer_cancel(conn);
+			tcp_ca_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1325,6 +2029,9 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+				conn->recv_options.sack_perm;
+			tcp_wscale_agree(conn);
 			if (len) {
 				if (tcp_data_get(conn, pkt) < 0) {
 					break;
@@ -1332,6 +2039,7 @@ next_state:
 				conn_ack(conn, + len);
 			}
 			k_sem_give(&conn->connect_sem);
+			tcp_ca_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1384,6 +2092,9 @@ next_state:
 			conn->unacked_len -= len_acked;
 			conn_seq(conn, + len_acked);
 
+			tcp_rtt_update(conn, th_ack(th));
+			tcp_ca_ack(conn, len_acked);
+
 			conn_send_data_dump(conn);
 
 			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
@@ -1408,6 +2119,20 @@ next_state:
 				break;
 			}
 
+			ret = tcp_send_queued_data(conn);
+			if (ret < 0 && ret != -ENOBUFS) {
+				tcp_out(conn, RST);
+				conn_state(conn, TCP_CLOSED);
+				break;
+			}
+		} else if (th && len == 0 && th_ack(th) == conn->seq &&
+			   conn->unacked_len > 0 &&
+			   conn->send_win == send_win &&
+			   conn->data_mode == TCP_DATA_MODE_SEND) {
+			/* Duplicate ACK, RFC 5681 chapter 2 */
+			tcp_ca_dup_ack(conn);
+
+			/* Fast recovery may send new data */
 			ret = tcp_send_queued_data(conn);
 			if (ret < 0 && ret != -ENOBUFS) {
 				tcp_out(conn, RST);
@@ -1418,13 +2143,30 @@ next_state:
 
 		if (th && len) {
 			if (th_seq(th) == conn->ack) {
+				/* Filling a gap is acknowledged right away */
+				bool gap = !sys_slist_is_empty(&conn->ooo_queue);
+
 				if (tcp_data_get(conn, pkt) < 0) {
 					break;
 				}
 				conn_ack(conn, + len);
-				tcp_out(conn, ACK);
+				tcp_ooo_deliver(conn);
+
+				if (gap) {
+					tcp_out(conn, ACK);
+				} else {
+					tcp_out_data_ack(conn);
+				}
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				tcp_out(conn, ACK); /* peer has resent */
+			} else {
+				/* A FIN is only accepted in sequence */
+				if (!(fl & FIN)) {
+					tcp_ooo_add(conn, pkt, th_seq(th), len);
+				}
+
+				/* Duplicate ACK tells the peer about the gap */
+				tcp_out(conn, ACK);
 			}
 		}
 		break;
@@ -1540,7 +2282,7 @@ int net_tcp_put(struct net_context *context)
 			/* How long to wait until all the data has been sent?
 			 */
 			k_delayed_work_submit(&conn->send_data_timer,
-					      K_MSEC(tcp_rto));
+					      K_MSEC(conn->rto));
 		} else {
 			int ret;
 
@@ -1611,6 +2353,15 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	/* The send buffer holds both unacknowledged and unsent data */
+	if (context->options.sndbuf > 0 &&
+	    conn->send_data_total >= (size_t)context->options.sndbuf) {
+		ret = -EAGAIN;
+		goto out;
+	}
+#endif
+
 	len = net_pkt_get_len(pkt);
 
 	if (conn->send_data->buffer) {
@@ -1738,6 +2489,8 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: %p src: %s, dst: %s", conn,
 		log_strdup(net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr)),
@@ -1882,7 +2635,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* The checksums of the segments are calculated once split */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -1931,6 +2686,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -2052,6 +2808,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -96,7 +96,7 @@
 #define conn_send_data_dump(_conn)					\
 ({									\
 	NET_DBG("conn: %p total=%zd, unacked_len=%d, "			\
-		"send_win=%hu, mss=%hu",				\
+		"send_win=%u, mss=%hu",				\
 		(_conn), net_pkt_get_len((_conn)->send_data),		\
 		conn->unacked_len, conn->send_win,			\
 		conn_mss((_conn)));					\
@@ -110,6 +110,11 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+#define TCP_SACK_MAX_BLOCKS 4
+#define TCP_WSCALE_MAX 14
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -171,20 +176,31 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+	struct tcp_sack_block sack[TCP_SACK_MAX_BLOCKS];
+	uint8_t num_sack;	/* SACK blocks in the last segment */
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm : 1;
 };
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_node;
+	sys_slist_t *hash_list;	/* lookup table bucket, if any */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
+	sys_slist_t ooo_queue;	/* out-of-order data by sequence */
 	union {
 		net_tcp_accept_cb_t accept_cb;
 		struct tcp *accepted_conn;
@@ -197,6 +213,7 @@ struct tcp { /* TCP connection */
 	struct k_delayed_work send_data_timer;
 	struct k_delayed_work timewait_timer;
 	struct k_delayed_work fin_timer;
+	struct k_delayed_work ack_timer;
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
 	size_t send_data_total;
@@ -207,12 +224,35 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t send_max;	/* highest sequence number sent so far */
+	uint32_t rtt_seq;	/* segment end being timed */
+	uint32_t rtt_start;	/* uptime when rtt_seq was sent */
+	int32_t srtt;		/* smoothed RTT in ms, scaled by 8 */
+	int32_t rttvar;		/* RTT variation in ms, scaled by 4 */
+	uint32_t rto;		/* retransmission timeout in ms */
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover;	/* send_max when fast recovery started */
+	uint32_t sack_high;	/* highest sequence SACKed by the peer */
+	uint32_t rexmit_next;	/* where to look for the next hole */
+	uint8_t dup_acks;
+#endif
+	size_t ooo_len;
+	uint32_t ooo_last;	/* sequence of the latest out-of-order data */
+	uint32_t recv_win;
+	uint32_t send_win;
+	uint8_t snd_wscale;	/* shift of the windows sent by the peer */
+	uint8_t rcv_wscale;	/* shift of the windows we advertise */
 	uint8_t send_data_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool rtt_pending : 1;
+	bool rtt_measured : 1;
+	bool in_recovery : 1;
+	bool sack_ok : 1;
+	bool ack_pending : 1;	/* received data waits for an ACK */
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
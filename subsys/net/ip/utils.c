@@ -489,32 +489,93 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+#if defined(CONFIG_ARCH_HAS_NET_CHKSUM)
+#define chksum_sum(data, len) arch_net_chksum(data, len)
+#else
+typedef uint32_t __may_alias chksum_u32_t;
+typedef uint16_t __may_alias chksum_u16_t;
+
+static inline uint16_t chksum_fold(uint64_t sum)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	uint32_t sum32;
 
-	end = data + len - 1;
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum32 = (sum & 0xffffffff) + (sum >> 32);
+	sum32 = (sum32 & 0xffff) + (sum32 >> 16);
+	sum32 = (sum32 & 0xffff) + (sum32 >> 16);
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	return sum32;
+}
 
+/* One's complement sum of the 16-bit words of the data as they are laid
+ * out in memory, RFC 1071. The words are loaded 32 bits at a time into a
+ * 64-bit accumulator, which cannot overflow for any packet size, so the
+ * carries are only folded in at the end.
+ */
+static uint16_t chksum_sum(const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len;
+	bool odd = POINTER_TO_UINT(data) & 1;
+	union {
+		uint16_t word;
+		uint8_t bytes[2];
+	} pad;
+	uint64_t sum = 0U;
+	uint16_t result;
+
+	if (len == 0U) {
+		return 0U;
+	}
+
+	/* Aligning the loads on an odd address swaps the bytes of every
+	 * word, which is undone once the sum is folded.
+	 */
+	if (odd) {
+		pad.bytes[0] = 0U;
+		pad.bytes[1] = *data++;
+		sum += pad.word;
+	}
+
+	if ((POINTER_TO_UINT(data) & 2) && end - data >= 2) {
+		sum += *(const chksum_u16_t *)data;
 		data += 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (end - data >= 16) {
+		const chksum_u32_t *words = (const chksum_u32_t *)data;
+
+		sum += (uint64_t)words[0] + words[1] + words[2] + words[3];
+		data += 16;
 	}
 
-	return sum;
+	while (end - data >= 4) {
+		sum += *(const chksum_u32_t *)data;
+		data += 4;
+	}
+
+	if (end - data >= 2) {
+		sum += *(const chksum_u16_t *)data;
+		data += 2;
+	}
+
+	if (data < end) {
+		pad.bytes[0] = *data;
+		pad.bytes[1] = 0U;
+		sum += pad.word;
+	}
+
+	result = chksum_fold(sum);
+
+	return odd ? __bswap_16(result) : result;
+}
+#endif /* CONFIG_ARCH_HAS_NET_CHKSUM */
+
+/* The partial sums are kept in host byte order */
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint32_t total = (uint32_t)sum + ntohs(chksum_sum(data, len));
+
+	return (total & 0xffff) + (total >> 16);
 }
 
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
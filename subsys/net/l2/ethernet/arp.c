@@ -19,16 +19,27 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #include "arp.h"
 #include "net_private.h"
+#include "net_stats.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
 
+BUILD_ASSERT((CONFIG_NET_ARP_HASH_SIZE &
+	      (CONFIG_NET_ARP_HASH_SIZE - 1)) == 0,
+	     "CONFIG_NET_ARP_HASH_SIZE must be a power of two");
+
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+
+/* The resolved entries are hashed by their IPv4 address. Every lookup
+ * hit stamps the entry with the next value of arp_lru_clock, the entry
+ * with the oldest stamp is taken out when the table is full.
+ */
+static sys_slist_t arp_table[CONFIG_NET_ARP_HASH_SIZE];
+static uint32_t arp_lru_clock;
 
 struct k_delayed_work arp_request_timer;
 
@@ -74,24 +85,44 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
+static inline sys_slist_t *arp_bucket(const struct in_addr *addr)
+{
+	/* The address may come from a packet header, which is unaligned */
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr) * 0x9e3779b1U;
+
+	hash ^= hash >> 16;
+
+	return &arp_table[hash & (CONFIG_NET_ARP_HASH_SIZE - 1)];
+}
+
+static void arp_entry_insert(struct arp_entry *entry)
+{
+	entry->last_used = ++arp_lru_clock;
+
+	sys_slist_prepend(arp_bucket(&entry->ip), &entry->node);
+}
+
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
+	sys_slist_t *bucket = arp_bucket(dst);
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find(bucket, iface, dst, &prev);
 	if (entry) {
+		entry->last_used = ++arp_lru_clock;
+
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
+		 * place the entry first in position into its bucket
 		 * in order to reduce subsequent find.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+		if (&entry->node != sys_slist_peek_head(bucket)) {
+			sys_slist_remove(bucket, prev, &entry->node);
+			sys_slist_prepend(bucket, &entry->node);
 		}
 	}
 
@@ -145,20 +176,29 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry, *oldest = NULL;
+	int i;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The least recently used entry is the preferred one to be
+	 * taken out.
 	 */
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			if (!oldest ||
+			    arp_lru_clock - entry->last_used >
+			    arp_lru_clock - oldest->last_used) {
+				oldest = entry;
+			}
+		}
+	}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
+	if (!oldest) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	sys_slist_find_and_remove(arp_bucket(&oldest->ip), &oldest->node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return oldest;
 }
 
 
@@ -353,6 +393,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	if (!entry) {
 		struct net_pkt *req;
 
+		net_stats_update_arp_miss(net_pkt_iface(pkt));
+
 		entry = arp_entry_find_pending(net_pkt_iface(pkt), addr);
 		if (!entry) {
 			/* No pending, let's try to get a new entry */
@@ -380,6 +422,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 		return req;
 	}
 
+	net_stats_update_arp_hit(net_pkt_iface(pkt));
+
 	net_pkt_lladdr_src(pkt)->addr =
 		(uint8_t *)net_if_get_link_addr(entry->iface)->addr;
 	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
@@ -402,7 +446,7 @@ static void arp_gratuitous(struct net_if *iface,
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(arp_bucket(src), iface, src, &prev);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -437,7 +481,8 @@ static void arp_update(struct net_if *iface,
 			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find(arp_bucket(src), iface, src,
+					       &prev);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -456,7 +501,7 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					arp_entry_insert(entry);
 				}
 			}
 		}
@@ -479,7 +524,7 @@ static void arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_entry_insert(entry);
 
 	net_if_queue_tx(iface, pkt);
 }
@@ -671,19 +716,25 @@ void net_arp_clear_cache(struct net_if *iface)
 {
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry, *next;
+	int i;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
-		if (iface && iface != entry->iface) {
-			prev = &entry->node;
-			continue;
-		}
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		prev = NULL;
 
-		arp_entry_cleanup(entry, false);
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table[i], entry, next,
+						  node) {
+			if (iface && iface != entry->iface) {
+				prev = &entry->node;
+				continue;
+			}
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+			arp_entry_cleanup(entry, false);
+
+			sys_slist_remove(&arp_table[i], prev, &entry->node);
+			sys_slist_prepend(&arp_free_entries, &entry->node);
+		}
 	}
 
 	prev = NULL;
@@ -712,10 +763,13 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 {
 	int ret = 0;
 	struct arp_entry *entry;
+	int i;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
-		ret++;
-		cb(entry, user_data);
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			ret++;
+			cb(entry, user_data);
+		}
 	}
 
 	return ret;
@@ -731,7 +785,10 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		sys_slist_init(&arp_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
@@ -52,6 +52,7 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 struct arp_entry {
 	sys_snode_t node;
 	uint32_t req_start;
+	uint32_t last_used;
 	struct net_if *iface;
 	struct in_addr ip;
 	union {
@@ -28,7 +28,9 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "arp.h"
 #include "eth_stats.h"
 #include "net_private.h"
+#include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 #include "ipv4_autoconf_internal.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
@@ -566,6 +568,140 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Room for the IP and TCP headers, both with options */
+#define GSO_MAX_HDR_LEN (NET_IPV6H_LEN + 2 * NET_IPV4H_LEN + 2 * NET_TCPH_LEN)
+
+/* Split a packet of several TCP segments for a driver without
+ * ETHERNET_HW_TSO. The segments get a copy of the headers, with the
+ * length, sequence number and checksums updated, and are sent in turn.
+ */
+static int ethernet_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint16_t mss = net_pkt_gso_size(pkt);
+	uint8_t hdr[GSO_MAX_HDR_LEN];
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_hdr_len, hdr_len;
+	size_t data_len, pos, len;
+	struct net_pkt *seg;
+	uint8_t flags;
+	uint32_t seq;
+	int ret = 0, sent = 0;
+
+	ip_hdr_len = net_pkt_ip_hdr_len(pkt);
+	if (net_pkt_family(pkt) == AF_INET) {
+		ip_hdr_len += net_pkt_ipv4_opts_len(pkt);
+	} else {
+		ip_hdr_len += net_pkt_ipv6_ext_len(pkt);
+	}
+
+	if (ip_hdr_len + NET_TCPH_LEN > sizeof(hdr)) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, hdr, ip_hdr_len + NET_TCPH_LEN)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(hdr + ip_hdr_len);
+	hdr_len = ip_hdr_len + NET_TCP_HDR_LEN(tcp_hdr);
+	if (hdr_len > sizeof(hdr) || hdr_len < ip_hdr_len + NET_TCPH_LEN ||
+	    net_pkt_read(pkt, hdr + ip_hdr_len + NET_TCPH_LEN,
+			 hdr_len - ip_hdr_len - NET_TCPH_LEN)) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+
+	for (pos = 0; pos < data_len; pos += len) {
+		len = MIN(mss, data_len - pos);
+
+		/* Only the last segment pushes or finishes */
+		if (pos + len < data_len) {
+			tcp_hdr->flags = flags & ~(NET_TCP_PSH | NET_TCP_FIN);
+		} else {
+			tcp_hdr->flags = flags;
+		}
+
+		sys_put_be32(seq + pos, tcp_hdr->seq);
+
+		seg = net_pkt_alloc_with_buffer(iface, hdr_len + len,
+						net_pkt_family(pkt),
+						IPPROTO_TCP, NET_BUF_TIMEOUT);
+		if (!seg) {
+			ret = -ENOMEM;
+			goto out;
+		}
+
+		net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+		net_pkt_set_priority(seg, net_pkt_priority(pkt));
+		net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+
+		/* net_if_send_data() filled in the addresses of pkt, and
+		 * IPv6 neighbor resolution the destination.  They point
+		 * outside of the buffer, so they are valid for seg too.
+		 */
+		memcpy(&seg->lladdr_src, &pkt->lladdr_src,
+		       sizeof(seg->lladdr_src));
+		memcpy(&seg->lladdr_dst, &pkt->lladdr_dst,
+		       sizeof(seg->lladdr_dst));
+
+		if (net_pkt_family(pkt) == AF_INET) {
+			net_pkt_set_ipv4_opts_len(seg,
+						  net_pkt_ipv4_opts_len(pkt));
+		} else {
+			net_pkt_set_ipv6_ext_len(seg,
+						 net_pkt_ipv6_ext_len(pkt));
+		}
+
+		if (net_pkt_write(seg, hdr, hdr_len) ||
+		    net_pkt_copy(seg, pkt, len)) {
+			net_pkt_unref(seg);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_pkt_cursor_init(seg);
+
+		if (net_pkt_family(seg) == AF_INET) {
+			ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+		} else {
+			ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+		}
+
+		if (ret == 0) {
+			net_pkt_cursor_init(seg);
+			ret = ethernet_send(iface, seg);
+		}
+
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+out:
+	/* Once a segment is out, a failure is handled like a lost
+	 * segment, TCP sends the missing data again.
+	 */
+	if (sent == 0) {
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -578,6 +714,13 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto error;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		return ethernet_gso_send(iface, pkt);
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
 		struct net_pkt *tmp;
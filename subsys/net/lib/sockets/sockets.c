@@ -787,6 +787,57 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	ssize_t len;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		len = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			/* The error is reported only if nothing was sent */
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	return vlen;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	for (i = 0; i < vlen; i++) {
+		len = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	return vlen;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -920,7 +971,128 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 	}
 }
 
+static int sock_put_cmsg(struct msghdr *msg, size_t *pos, int level,
+			 int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (*pos + CMSG_SPACE(len) > msg->msg_controllen) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return -ENOMEM;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control + *pos);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	*pos += CMSG_SPACE(len);
+
+	return 0;
+}
+
+static void sock_put_pktinfo(struct net_pkt *pkt, struct msghdr *msg,
+			     size_t *pos)
+{
+	struct net_pkt_cursor backup;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct in_pktinfo info = {
+			.ipi_ifindex = net_if_get_by_iface(net_pkt_iface(pkt)),
+		};
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (ipv4_hdr) {
+			net_ipaddr_copy(&info.ipi_spec_dst, &ipv4_hdr->dst);
+			net_ipaddr_copy(&info.ipi_addr, &ipv4_hdr->dst);
+			sock_put_cmsg(msg, pos, IPPROTO_IP, IP_PKTINFO,
+				      &info, sizeof(info));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct in6_pktinfo info = {
+			.ipi6_ifindex = net_if_get_by_iface(net_pkt_iface(pkt)),
+		};
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (ipv6_hdr) {
+			net_ipaddr_copy(&info.ipi6_addr, &ipv6_hdr->dst);
+			sock_put_cmsg(msg, pos, IPPROTO_IPV6, IPV6_PKTINFO,
+				      &info, sizeof(info));
+		}
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+}
+
+/* Fill in the ancillary data of recvmsg() that the socket options ask for */
+static void sock_put_ancillary(struct net_context *ctx, struct net_pkt *pkt,
+			       struct msghdr *msg)
+{
+	size_t pos = 0;
+	int enabled = 0;
+
+	if (!msg->msg_control) {
+		msg->msg_controllen = 0;
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO) &&
+	    net_context_get_option(ctx, NET_OPT_RECV_PKTINFO,
+				   &enabled, NULL) == 0 && enabled) {
+		sock_put_pktinfo(pkt, msg, &pos);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP)) {
+		bool timestamp = false;
+
+		net_context_get_option(ctx, NET_OPT_TIMESTAMP, &timestamp,
+				       NULL);
+		if (timestamp) {
+			sock_put_cmsg(msg, &pos, SOL_SOCKET, SO_TIMESTAMPING,
+				      net_pkt_timestamp(pkt),
+				      sizeof(struct net_ptp_time));
+		}
+	}
+
+	msg->msg_controllen = pos;
+}
+
+static int sock_read_iov(struct net_pkt *pkt, struct msghdr *msg,
+			 size_t len)
+{
+	size_t i, chunk;
+
+	for (i = 0; i < msg->msg_iovlen && len > 0; i++) {
+		chunk = MIN(msg->msg_iov[i].iov_len, len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, chunk)) {
+			return -ENOBUFS;
+		}
+
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+/* If msg is not NULL, the data is read into its iovecs and its flags and
+ * ancillary data are set, buf is not used then.
+ */
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       struct msghdr *msg,
 				       void *buf,
 				       size_t max_len,
 				       int flags,
@@ -984,9 +1156,20 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	recv_len = net_pkt_remaining_data(pkt);
 	if (recv_len > max_len) {
 		recv_len = max_len;
+
+		if (msg) {
+			msg->msg_flags |= ZSOCK_MSG_TRUNC;
+		}
 	}
 
-	if (net_pkt_read(pkt, buf, recv_len)) {
+	if (msg) {
+		sock_put_ancillary(ctx, pkt, msg);
+
+		if (sock_read_iov(pkt, msg, recv_len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+	} else if (net_pkt_read(pkt, buf, recv_len)) {
 		errno = ENOBUFS;
 		goto fail;
 	}
@@ -1114,7 +1297,8 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		return zsock_recv_dgram(ctx, NULL, buf, max_len, flags,
+					src_addr, addrlen);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1162,6 +1346,371 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static ssize_t zsock_recvmsg_stream(struct net_context *ctx,
+				    struct msghdr *msg, int flags)
+{
+	ssize_t total = 0;
+	ssize_t len;
+	size_t i;
+
+	/* Fill the iovecs in turn, without blocking once there is data */
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+
+		len = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					msg->msg_iov[i].iov_len,
+					total ? flags | ZSOCK_MSG_DONTWAIT :
+						flags);
+		if (len < 0) {
+			return total ? total : -1;
+		}
+
+		total += len;
+
+		if ((size_t)len < msg->msg_iov[i].iov_len ||
+		    (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	size_t i, max_len = 0;
+
+	if (msg == NULL || (msg->msg_iovlen > 0 && msg->msg_iov == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		max_len += msg->msg_iov[i].iov_len;
+	}
+
+	msg->msg_flags = 0;
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, NULL, max_len, flags,
+					msg->msg_name,
+					msg->msg_name ? &msg->msg_namelen :
+							NULL);
+	} else if (sock_type == SOCK_STREAM) {
+		msg->msg_controllen = 0;
+
+		return zsock_recvmsg_stream(ctx, msg, flags);
+	}
+
+	__ASSERT(0, "Unknown socket type");
+
+	errno = ENOTSUP;
+	return -1;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	struct iovec *iov = NULL;
+	ssize_t ret = -1;
+	size_t i;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+
+	/* The data is written to the user buffers, which must be writable.
+	 * The iovec array is copied so that it cannot change meanwhile.
+	 * There is nothing to copy for a message without buffers.
+	 */
+	if (msg_copy.msg_iovlen > 0) {
+		iov = z_user_alloc_from_copy(msg_copy.msg_iov,
+					     msg_copy.msg_iovlen *
+					     sizeof(struct iovec));
+		if (!iov) {
+			errno = ENOMEM;
+			return -1;
+		}
+	}
+
+	msg_copy.msg_iov = iov;
+
+	for (i = 0; i < msg_copy.msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(iov[i].iov_base, iov[i].iov_len)) {
+			errno = EFAULT;
+			goto out;
+		}
+	}
+
+	if ((msg_copy.msg_name &&
+	     Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_name,
+				    msg_copy.msg_namelen)) ||
+	    (msg_copy.msg_control &&
+	     Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_control,
+				    msg_copy.msg_controllen))) {
+		errno = EFAULT;
+		goto out;
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	Z_OOPS(z_user_to_copy(&msg->msg_namelen, &msg_copy.msg_namelen,
+			      sizeof(msg_copy.msg_namelen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_controllen, &msg_copy.msg_controllen,
+			      sizeof(msg_copy.msg_controllen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_flags, &msg_copy.msg_flags,
+			      sizeof(msg_copy.msg_flags)));
+
+out:
+	k_free(iov);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	ssize_t len;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->recvmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		len = vtable->recvmsg(ctx, &msgvec[i].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (len < 0) {
+			/* The error is reported only if nothing was received */
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return vlen;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	for (i = 0; i < vlen; i++) {
+		len = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr,
+					   flags & ~ZSOCK_MSG_WAITFORONE);
+		if (len < 0) {
+			return i > 0 ? i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return vlen;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+/* Point the views at the data from the cursor on, one per fragment */
+static size_t sock_lend_frags(struct net_pkt *pkt, struct zsock_zerocopy *zc,
+			      size_t max_views)
+{
+	struct net_buf *frag = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t total = 0;
+
+	while (frag && zc->iovlen < max_views) {
+		size_t len = frag->len - (pos - frag->data);
+
+		if (len > 0) {
+			zc->iov[zc->iovlen].iov_base = pos;
+			zc->iov[zc->iovlen].iov_len = len;
+			zc->iovlen++;
+			total += len;
+		}
+
+		frag = frag->frags;
+		if (frag) {
+			pos = frag->data;
+		}
+	}
+
+	return total;
+}
+
+static ssize_t zsock_recv_zerocopy_dgram(struct net_context *ctx,
+					 struct zsock_zerocopy *zc,
+					 size_t max_views,
+					 k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	size_t len;
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	len = sock_lend_frags(pkt, zc, max_views);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	/* The reference of the queue is handed over to the caller */
+	zc->pkt = pkt;
+
+	return len;
+}
+
+static ssize_t zsock_recv_zerocopy_stream(struct net_context *ctx,
+					  struct zsock_zerocopy *zc,
+					  size_t max_views,
+					  k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	size_t len;
+	int res;
+
+	if (!net_context_is_used(ctx)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	while (true) {
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		res = k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled */
+		if (res && res != -EAGAIN && res != -EINTR) {
+			errno = -res;
+			return -1;
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		len = sock_lend_frags(pkt, zc, max_views);
+		if (len > 0 && len < net_pkt_remaining_data(pkt)) {
+			/* The rest stays queued for the next call */
+			net_pkt_skip(pkt, len);
+			zc->pkt = net_pkt_ref(pkt);
+			break;
+		}
+
+		k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (len == 0) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		zc->pkt = pkt;
+		break;
+	}
+
+	net_context_update_recv_wnd(ctx, len);
+
+	return len;
+}
+
+ssize_t zsock_recv_zerocopy(int sock, struct zsock_zerocopy *zc, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	size_t max_views;
+
+	ctx = z_get_fd_obj(sock,
+			   (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			   ENOTSUP);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (zc == NULL || zc->iov == NULL || zc->iovlen == 0 ||
+	    (flags & ZSOCK_MSG_PEEK)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	max_views = zc->iovlen;
+	zc->iovlen = 0;
+	zc->pkt = NULL;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	switch (net_context_get_type(ctx)) {
+	case SOCK_DGRAM:
+		return zsock_recv_zerocopy_dgram(ctx, zc, max_views, timeout);
+	case SOCK_STREAM:
+		return zsock_recv_zerocopy_stream(ctx, zc, max_views, timeout);
+	default:
+		break;
+	}
+
+	errno = ENOTSUP;
+	return -1;
+}
+
+void zsock_recv_zerocopy_release(struct zsock_zerocopy *zc)
+{
+	if (zc->pkt) {
+		net_pkt_unref(zc->pkt);
+		zc->pkt = NULL;
+	}
+
+	zc->iovlen = 0;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1498,6 +2047,78 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 				return 0;
 			}
+
+			break;
+
+		case SO_RCVBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RCVBUF,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case SO_SNDBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_SNDBUF,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+
+		break;
+
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(
+					ctx, NET_OPT_RECV_PKTINFO,
+					optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+
+		break;
+
+	case IPPROTO_IPV6:
+		switch (optname) {
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_get_option(
+					ctx, NET_OPT_RECV_PKTINFO,
+					optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 
 		break;
@@ -1619,6 +2240,56 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case SO_RCVBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RCVBUF,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case SO_SNDBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_SNDBUF,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+
+		break;
+
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(
+					ctx, NET_OPT_RECV_PKTINFO,
+					optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -1641,6 +2312,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO)) {
+				ret = net_context_set_option(
+					ctx, NET_OPT_RECV_PKTINFO,
+					optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 		break;
 	}
@@ -1861,6 +2547,11 @@ static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -1906,6 +2597,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getsockname = sock_getsockname_vmeth,
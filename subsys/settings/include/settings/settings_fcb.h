@@ -18,6 +18,12 @@ extern "C" {
 struct settings_fcb {
 	struct settings_store cf_store;
 	struct fcb cf_fcb;
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+	/* latest index record, covering cf_index_cnt entries if not 0 */
+	struct fcb_entry cf_index;
+	uint16_t cf_index_cnt;
+	bool cf_index_found;
+#endif
 };
 
 extern int settings_fcb_src(struct settings_fcb *cf);
@@ -38,6 +38,12 @@ struct settings_nvs {
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const char *flash_dev_name;
+	bool save_in_progress;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	/* name hash of every name id from NVS_NAMECNT_ID + 1 on, 0 if free */
+	uint16_t name_index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	bool name_index_valid;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -32,6 +32,32 @@ static const struct settings_store_itf settings_fcb_itf = {
 	.csi_save = settings_fcb_save,
 };
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+/* The index record, written by every compression, has a bit for each of
+ * the entries that precede it, from the first one of the oldest sector on.
+ * The bit is set if the entry was the latest one of its name then. Loading
+ * skips the entries with a clear bit without reading them, and looks for
+ * newer values of the others only after the index record.
+ */
+#define SETTINGS_FCB_INDEX_NAME ".index"
+
+struct settings_fcb_index_hdr {
+	uint16_t cnt;		/* number of entries covered */
+	uint16_t oldest;	/* oldest sector, as position in f_sectors */
+};
+
+static struct {
+	struct settings_fcb_index_hdr hdr;
+	uint8_t map[(CONFIG_SETTINGS_FCB_INDEX_SIZE + 7) / 8];
+} settings_fcb_index_rec;
+
+enum settings_fcb_entry_state {
+	SETTINGS_FCB_ENTRY_NEW,		/* not covered by the index */
+	SETTINGS_FCB_ENTRY_OLD,		/* superseded by a newer entry */
+	SETTINGS_FCB_ENTRY_LATEST,	/* latest of its name when indexed */
+};
+#endif
+
 int settings_fcb_src(struct settings_fcb *cf)
 {
 	int rc;
@@ -64,6 +90,11 @@ int settings_fcb_src(struct settings_fcb *cf)
 		}
 	}
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+	cf->cf_index_cnt = 0U;
+	cf->cf_index_found = false;
+#endif
+
 	cf->cf_store.cs_itf = &settings_fcb_itf;
 	settings_src_register(&cf->cf_store);
 
@@ -121,10 +152,89 @@ static int read_entry_len(const struct fcb_entry_ctx *entry_ctx, off_t off)
 	return entry_ctx->loc.fe_data_len - off;
 }
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+static bool settings_fcb_is_index(const char *name, size_t name_len)
+{
+	return name_len == sizeof(SETTINGS_FCB_INDEX_NAME) - 1 &&
+	       !memcmp(name, SETTINGS_FCB_INDEX_NAME, name_len);
+}
+
+/* Find the latest index record, provided the entries it covers are still
+ * the ones from the start of the oldest sector.
+ */
+static void settings_fcb_index_find(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		{.fe_sector = NULL, .fe_elem_off = 0},
+		.fap = cf->cf_fcb.fap
+	};
+	struct settings_fcb_index_hdr hdr;
+	char name[sizeof(SETTINGS_FCB_INDEX_NAME)];
+	size_t name_len, len;
+	uint32_t n;
+
+	cf->cf_index_cnt = 0U;
+	cf->cf_index_found = true;
+
+	for (n = 0; fcb_getnext(&cf->cf_fcb, &entry_ctx.loc) == 0; n++) {
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx) ||
+		    !settings_fcb_is_index(name, name_len)) {
+			continue;
+		}
+
+		if (settings_line_val_read(name_len + 1, 0, (char *)&hdr,
+					   sizeof(hdr), &len, &entry_ctx) ||
+		    len != sizeof(hdr) ||
+		    settings_line_val_get_len(name_len + 1, &entry_ctx) <
+		    sizeof(hdr) + (hdr.cnt + 7) / 8) {
+			continue;
+		}
+
+		if (hdr.cnt <= n &&
+		    hdr.oldest == cf->cf_fcb.f_oldest - cf->cf_fcb.f_sectors) {
+			cf->cf_index = entry_ctx.loc;
+			cf->cf_index_cnt = hdr.cnt;
+		}
+	}
+}
+
+/* State of the i-th entry from the start of the oldest sector. The entries
+ * are expected in order, bits holds the index byte of the current ones.
+ */
+static enum settings_fcb_entry_state
+settings_fcb_index_get(struct settings_fcb *cf, uint32_t i, uint8_t *bits)
+{
+	struct fcb_entry_ctx index_ctx = {
+		.loc = cf->cf_index,
+		.fap = cf->cf_fcb.fap
+	};
+	size_t len;
+
+	if (i >= cf->cf_index_cnt) {
+		return SETTINGS_FCB_ENTRY_NEW;
+	}
+
+	if (i % 8 == 0 &&
+	    (settings_line_val_read(sizeof(SETTINGS_FCB_INDEX_NAME),
+				    sizeof(struct settings_fcb_index_hdr) +
+				    i / 8, (char *)bits, 1, &len,
+				    &index_ctx) || len != 1)) {
+		LOG_ERR("Failed to read the index");
+		cf->cf_index_cnt = 0U;
+		return SETTINGS_FCB_ENTRY_NEW;
+	}
+
+	return (*bits & BIT(i % 8)) ? SETTINGS_FCB_ENTRY_LATEST :
+				      SETTINGS_FCB_ENTRY_OLD;
+}
+#endif
+
 static int settings_fcb_load_priv(struct settings_store *cs,
 				  line_load_cb cb,
 				  void *cb_arg,
-				  bool filter_duplicates)
+				  bool filter_duplicates,
+				  const char *subtree)
 {
 	struct settings_fcb *cf = (struct settings_fcb *)cs;
 	struct fcb_entry_ctx entry_ctx = {
@@ -132,13 +242,38 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 		.fap = cf->cf_fcb.fap
 	};
 	int rc;
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+	struct fcb_entry_ctx index_ctx;
+	uint32_t i = 0;
+	uint8_t bits;
+
+	if (!cf->cf_index_found) {
+		settings_fcb_index_find(cf);
+	}
+	index_ctx.loc = cf->cf_index;
+	index_ctx.fap = cf->cf_fcb.fap;
+#endif
 
 	while ((rc = fcb_getnext(&cf->cf_fcb, &entry_ctx.loc)) == 0) {
 		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		const struct fcb_entry_ctx *newer_ctx = &entry_ctx;
 		size_t name_len;
 		int rc;
 		bool pass_entry = true;
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+		switch (settings_fcb_index_get(cf, i++, &bits)) {
+		case SETTINGS_FCB_ENTRY_OLD:
+			continue;
+		case SETTINGS_FCB_ENTRY_LATEST:
+			/* Newer values can only follow the index */
+			newer_ctx = &index_ctx;
+			break;
+		default:
+			break;
+		}
+#endif
+
 		rc = settings_line_name_read(name, sizeof(name), &name_len,
 					     (void *)&entry_ctx);
 		if (rc) {
@@ -147,9 +282,20 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 		}
 		name[name_len] = '\0';
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+		if (settings_fcb_is_index(name, name_len)) {
+			continue;
+		}
+#endif
+
+		/* Spare the search for duplicates of other subtrees */
+		if (subtree && !settings_name_steq(name, subtree, NULL)) {
+			continue;
+		}
+
 		if (filter_duplicates &&
 		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_fcb_check_duplicate(cf, &entry_ctx, name))) {
+		     settings_fcb_check_duplicate(cf, newer_ctx, name))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
@@ -171,7 +317,8 @@ static int settings_fcb_load(struct settings_store *cs,
 		cs,
 		settings_line_load_cb,
 		(void *)arg,
-		true);
+		true,
+		arg ? arg->subtree : NULL);
 }
 
 static int read_handler(void *ctx, off_t off, char *buf, size_t *len)
@@ -192,6 +339,100 @@ static int read_handler(void *ctx, off_t off, char *buf, size_t *len)
 			       *len);
 }
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+/* Mark the latest entries, other than the ones of the oldest sector, in
+ * settings_fcb_index_rec.
+ */
+static void settings_fcb_index_build(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		{.fe_sector = NULL, .fe_elem_off = 0},
+		.fap = cf->cf_fcb.fap
+	};
+	struct fcb_entry_ctx index_ctx;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	enum settings_fcb_entry_state state;
+	size_t name_len;
+	uint32_t i = 0;
+	uint16_t n = 0U;
+	uint8_t bits;
+	bool latest;
+
+	if (!cf->cf_index_found) {
+		settings_fcb_index_find(cf);
+	}
+	index_ctx.loc = cf->cf_index;
+	index_ctx.fap = cf->cf_fcb.fap;
+
+	(void)memset(&settings_fcb_index_rec, 0,
+		     sizeof(settings_fcb_index_rec));
+
+	while (n < CONFIG_SETTINGS_FCB_INDEX_SIZE &&
+	       fcb_getnext(&cf->cf_fcb, &entry_ctx.loc) == 0) {
+		state = settings_fcb_index_get(cf, i++, &bits);
+		if (entry_ctx.loc.fe_sector == cf->cf_fcb.f_oldest) {
+			continue;
+		}
+
+		latest = false;
+		if (state != SETTINGS_FCB_ENTRY_OLD &&
+		    !settings_line_name_read(name, sizeof(name), &name_len,
+					     &entry_ctx) &&
+		    !settings_fcb_is_index(name, name_len)) {
+			name[name_len] = '\0';
+			latest = !settings_fcb_check_duplicate(cf,
+				(state == SETTINGS_FCB_ENTRY_LATEST) ?
+				&index_ctx : &entry_ctx, name);
+		}
+
+		if (latest) {
+			settings_fcb_index_rec.map[n / 8] |= BIT(n % 8);
+		}
+		n++;
+	}
+
+	settings_fcb_index_rec.hdr.cnt = n;
+}
+
+/* Store settings_fcb_index_rec, once the oldest sector has been erased */
+static void settings_fcb_index_write(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx loc;
+	size_t val_len;
+	int rc, rc2;
+
+	settings_fcb_index_rec.hdr.oldest =
+		cf->cf_fcb.f_oldest - cf->cf_fcb.f_sectors;
+	val_len = sizeof(settings_fcb_index_rec.hdr) +
+		  (settings_fcb_index_rec.hdr.cnt + 7) / 8;
+
+	loc.loc.fe_data_len = settings_line_len_calc(SETTINGS_FCB_INDEX_NAME,
+						     val_len);
+	rc = fcb_append(&cf->cf_fcb, loc.loc.fe_data_len, &loc.loc);
+	if (rc == 0) {
+		loc.fap = cf->cf_fcb.fap;
+		rc = settings_line_write(SETTINGS_FCB_INDEX_NAME,
+					 (char *)&settings_fcb_index_rec,
+					 val_len, 0, &loc);
+		if (rc != -EIO) {
+			rc2 = fcb_append_finish(&cf->cf_fcb, &loc.loc);
+			if (!rc) {
+				rc = rc2;
+			}
+		}
+	}
+
+	if (rc) {
+		LOG_WRN("Failed to write the index (%d)", rc);
+		cf->cf_index_found = false;
+		return;
+	}
+
+	cf->cf_index = loc.loc;
+	cf->cf_index_cnt = settings_fcb_index_rec.hdr.cnt;
+}
+#endif
+
 static void settings_fcb_compress(struct settings_fcb *cf)
 {
 	int rc;
@@ -234,6 +475,13 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 			continue;
 		}
 
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+		/* A new index is written below */
+		if (settings_fcb_is_index(name1, val1_off)) {
+			continue;
+		}
+#endif
+
 		loc2 = loc1;
 		copy = 1;
 
@@ -275,11 +523,24 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 			LOG_ERR("Failed to finish fcb_append (%d)", rc);
 		}
 	}
+
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+	settings_fcb_index_build(cf);
+#endif
+
 	rc = fcb_rotate(&cf->cf_fcb);
 
 	if (rc != 0) {
 		LOG_ERR("Failed to fcb rotate (%d)", rc);
 	}
+
+#if defined(CONFIG_SETTINGS_FCB_INDEX)
+	if (rc == 0) {
+		settings_fcb_index_write(cf);
+	} else {
+		cf->cf_index_found = false;
+	}
+#endif
 }
 
 static size_t get_len_cb(void *ctx)
@@ -360,7 +621,8 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
-	settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
+	settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca, false,
+			       NULL);
 	if (cdca.is_dup == 1) {
 		return 0;
 	}
@@ -32,6 +32,18 @@ static const struct settings_store_itf settings_file_itf = {
 	.csi_save = settings_file_save,
 };
 
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+/* A compressed file starts with the index line, its value is the file offset
+ * up to which the following lines hold distinct names. Loading looks for
+ * newer values of these only past that offset.
+ */
+#define SETTINGS_FILE_INDEX_NAME ".index"
+
+/* Offset of the index value in the file, after the length and the name */
+#define SETTINGS_FILE_INDEX_VAL_OFF \
+	(sizeof(uint16_t) + sizeof(SETTINGS_FILE_INDEX_NAME))
+#endif
+
 /*
  * Register a file to be a source of configuration.
  */
@@ -107,8 +119,31 @@ static int read_entry_len(const struct line_entry_ctx *entry_ctx, off_t off)
 	return entry_ctx->len - off;
 }
 
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+static bool settings_file_is_index(const char *name, size_t name_len)
+{
+	return name_len == sizeof(SETTINGS_FILE_INDEX_NAME) - 1 &&
+	       !memcmp(name, SETTINGS_FILE_INDEX_NAME, name_len);
+}
+
+static off_t settings_file_index_end(struct line_entry_ctx *entry_ctx,
+				     size_t name_len)
+{
+	uint32_t end;
+	size_t len;
+
+	if (settings_line_val_read(name_len + 1, 0, (char *)&end, sizeof(end),
+				   &len, entry_ctx) || len != sizeof(end)) {
+		return 0;
+	}
+
+	return end;
+}
+#endif
+
 static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
-				   void *cb_arg, bool filter_duplicates)
+				   void *cb_arg, bool filter_duplicates,
+				   const char *subtree)
 {
 	struct settings_file *cf = (struct settings_file *)cs;
 	struct fs_file_t file;
@@ -120,6 +155,13 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 		.seek = 0,
 		.len = 0 /* unknown length */
 	};
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+	struct line_entry_ctx tail_ctx = {
+		.stor_ctx = (void *)&file,
+		.seek = 0,
+		.len = 0
+	};
+#endif
 
 	lines = 0;
 
@@ -130,6 +172,7 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 
 	while (1) {
 		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		const struct line_entry_ctx *newer_ctx = &entry_ctx;
 		size_t name_len;
 		bool pass_entry = true;
 
@@ -146,9 +189,24 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 		}
 		name[name_len] = '\0';
 
-		if (filter_duplicates &&
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+		if (lines == 0 && settings_file_is_index(name, name_len)) {
+			tail_ctx.seek = settings_file_index_end(&entry_ctx,
+								name_len);
+			pass_entry = false;
+		} else if (entry_ctx.seek < tail_ctx.seek) {
+			newer_ctx = &tail_ctx;
+		}
+#endif
+
+		/* Spare the search for duplicates of other subtrees */
+		if (subtree && !settings_name_steq(name, subtree, NULL)) {
+			pass_entry = false;
+		}
+
+		if (pass_entry && filter_duplicates &&
 		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_file_check_duplicate(&entry_ctx, name))) {
+		     settings_file_check_duplicate(newer_ctx, name))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
@@ -174,7 +232,8 @@ static int settings_file_load(struct settings_store *cs,
 	return settings_file_load_priv(cs,
 				       settings_line_load_cb,
 				       (void *)arg,
-				       true);
+				       true,
+				       arg ? arg->subtree : NULL);
 }
 
 static void settings_tmpfile(char *dst, const char *src, char *pfx)
@@ -239,6 +298,9 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	int lines;
 	size_t new_name_len;
 	size_t val1_off;
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+	uint32_t index_end = 0U;
+#endif
 
 	if (fs_open(&rf, cf->cf_name, FS_O_CREATE | FS_O_RDWR) != 0) {
 		return -ENOEXEC;
@@ -254,6 +316,16 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	lines = 0;
 	new_name_len = strlen(name);
 
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+	/* The end of the distinct lines is filled in below */
+	rc = settings_line_write(SETTINGS_FILE_INDEX_NAME, (char *)&index_end,
+				 sizeof(index_end), 0, &loc3);
+	if (rc) {
+		goto end_rolback;
+	}
+	lines++;
+#endif
+
 	while (1) {
 		rc = settings_next_line_ctx(&loc1);
 
@@ -276,6 +348,13 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 			continue;
 		}
 
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+		/* A new index line was written */
+		if (settings_file_is_index(name1, val1_off)) {
+			continue;
+		}
+#endif
+
 		/* avoid copping value which will be overwritten by new value*/
 		if ((val1_off == new_name_len) &&
 		    !memcmp(name1, name, val1_off)) {
@@ -331,6 +410,18 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 		goto end_rolback;
 	}
 
+#if defined(CONFIG_SETTINGS_FS_INDEX)
+	index_end = fs_tell(&wf);
+	rc = fs_seek(&wf, SETTINGS_FILE_INDEX_VAL_OFF, FS_SEEK_SET);
+	if (rc == 0 &&
+	    fs_write(&wf, &index_end, sizeof(index_end)) != sizeof(index_end)) {
+		rc = -EIO;
+	}
+	if (rc) {
+		goto end_rolback;
+	}
+#endif
+
 	rc = fs_close(&wf);
 	rc2 = fs_close(&rf);
 	if (rc == 0 && rc2 == 0 && fs_unlink(cf->cf_name) == 0) {
@@ -421,7 +512,8 @@ static int settings_file_save(struct settings_store *cs, const char *name,
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
-	settings_file_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
+	settings_file_load_priv(cs, settings_line_dup_check_cb, &cdca, false,
+				NULL);
 	if (cdca.is_dup == 1) {
 		return 0;
 	}
@@ -13,6 +13,7 @@
 
 #include "settings/settings.h"
 #include "settings/settings_file.h"
+#include "settings_priv.h"
 #include <zephyr.h>
 
 
@@ -35,6 +36,12 @@ int settings_subsys_init(void)
 
 	err = settings_backend_init(); /* func rises kernel panic once error */
 
+#if defined(CONFIG_SETTINGS_BATCH)
+	if (!err) {
+		err = settings_batch_recover();
+	}
+#endif
+
 	if (!err) {
 		settings_subsys_initialized = true;
 	}
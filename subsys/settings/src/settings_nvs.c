@@ -12,6 +12,7 @@
 #include "settings/settings_nvs.h"
 #include "settings_priv.h"
 #include <storage/flash_map.h>
+#include <sys/crc.h>
 
 #include <logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -25,10 +26,14 @@ static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+static int settings_nvs_save_start(struct settings_store *cs);
+static int settings_nvs_save_end(struct settings_store *cs);
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
+	.csi_save_start = settings_nvs_save_start,
+	.csi_save_end = settings_nvs_save_end,
 };
 
 static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
@@ -48,6 +53,125 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+/* The name index holds a hash of the name stored at every name id, or 0 if
+ * the name id is free. It is complete when it covers cf->last_name_id, a
+ * name is then found by reading only the names with the same hash.
+ */
+static uint16_t settings_nvs_name_hash(const char *name, size_t len)
+{
+	uint16_t hash = crc16_ccitt(0xffff, (const uint8_t *)name, len);
+
+	/* 0 marks a free name id */
+	return hash ? hash : 1;
+}
+
+static bool settings_nvs_index_covers(uint16_t name_id)
+{
+	return name_id - NVS_NAMECNT_ID <= CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE;
+}
+
+static void settings_nvs_index_set(struct settings_nvs *cf, uint16_t name_id,
+				   uint16_t hash)
+{
+	if (settings_nvs_index_covers(name_id)) {
+		cf->name_index[name_id - NVS_NAMECNT_ID - 1] = hash;
+	}
+}
+
+static void settings_nvs_index_build(struct settings_nvs *cf)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t name_id;
+	ssize_t rc;
+
+	(void)memset(cf->name_index, 0, sizeof(cf->name_index));
+
+	for (name_id = NVS_NAMECNT_ID + 1; name_id <= cf->last_name_id &&
+	     settings_nvs_index_covers(name_id); name_id++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		if (rc > 0) {
+			settings_nvs_index_set(cf, name_id,
+				settings_nvs_name_hash(name,
+						       MIN(rc, sizeof(name))));
+		}
+	}
+
+	cf->name_index_valid = true;
+}
+#endif
+
+/* Find the name id under which name is stored, NVS_NAMECNT_ID if there is
+ * none. free_id is set to the lowest name id that is not in use.
+ */
+static uint16_t settings_nvs_name_find(struct settings_nvs *cf,
+				       const char *name, uint16_t *free_id)
+{
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t name_id;
+	ssize_t rc;
+
+	*free_id = cf->last_name_id + 1;
+
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	if (!cf->name_index_valid) {
+		settings_nvs_index_build(cf);
+	}
+
+	if (settings_nvs_index_covers(cf->last_name_id)) {
+		uint16_t hash = settings_nvs_name_hash(name, strlen(name));
+		uint16_t entry;
+
+		for (name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID;
+		     name_id--) {
+			entry = cf->name_index[name_id - NVS_NAMECNT_ID - 1];
+
+			if (entry == 0U) {
+				*free_id = name_id;
+				continue;
+			}
+
+			if (entry != hash) {
+				continue;
+			}
+
+			rc = nvs_read(&cf->cf_nvs, name_id, &rdname,
+				      sizeof(rdname));
+			if (rc < 0) {
+				continue;
+			}
+
+			rdname[rc] = '\0';
+			if (!strcmp(name, rdname)) {
+				return name_id;
+			}
+		}
+
+		return NVS_NAMECNT_ID;
+	}
+#endif
+
+	for (name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID; name_id--) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
+
+		if (rc < 0) {
+			/* Error or entry not found */
+			if (rc == -ENOENT) {
+				*free_id = name_id;
+			}
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			return name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -75,6 +199,12 @@ static int settings_nvs_load(struct settings_store *cs,
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	/* The names are all read anyway, the index is rebuilt on the way */
+	cf->name_index_valid = false;
+	(void)memset(cf->name_index, 0, sizeof(cf->name_index));
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -114,6 +244,10 @@ static int settings_nvs_load(struct settings_store *cs,
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		settings_nvs_index_set(cf, name_id,
+				       settings_nvs_name_hash(name, rc1));
+#endif
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -125,14 +259,52 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	cf->name_index_valid = (ret == 0);
+#endif
 	return ret;
 }
 
+/* Store the largest name id in use, unless an export operation is in
+ * progress, then settings_nvs_save_end() stores it once at the end.
+ */
+static int settings_nvs_namecnt_write(struct settings_nvs *cf)
+{
+	if (cf->save_in_progress) {
+		return 0;
+	}
+
+	return nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
+			 sizeof(uint16_t));
+}
+
+static int settings_nvs_save_start(struct settings_store *cs)
+{
+	struct settings_nvs *cf = (struct settings_nvs *)cs;
+
+	cf->save_in_progress = true;
+
+	return 0;
+}
+
+static int settings_nvs_save_end(struct settings_store *cs)
+{
+	struct settings_nvs *cf = (struct settings_nvs *)cs;
+	int rc;
+
+	cf->save_in_progress = false;
+
+	/* Nothing is written if the value did not change */
+	rc = settings_nvs_namecnt_write(cf);
+
+	return (rc < 0) ? rc : 0;
+}
+
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len)
 {
 	struct settings_nvs *cf = (struct settings_nvs *)cs;
-	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
 	int rc = 0;
@@ -144,36 +316,18 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
-	name_id = cf->last_name_id + 1;
-	write_name_id = cf->last_name_id + 1;
-	write_name = true;
-
-	while (1) {
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
-		}
-
-		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
-
-		if (rc < 0) {
-			/* Error or entry not found */
-			if (rc == -ENOENT) {
-				write_name_id = name_id;
-			}
-			continue;
-		}
+	name_id = settings_nvs_name_find(cf, name, &write_name_id);
+	write_name = (name_id == NVS_NAMECNT_ID);
 
-		rdname[rc] = '\0';
-
-		if (strcmp(name, rdname)) {
-			continue;
+	if (delete) {
+		if (write_name) {
+			/* Nothing stored under this name */
+			return 0;
 		}
 
-		if ((delete) && (name_id == cf->last_name_id)) {
+		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
-			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-				       &cf->last_name_id, sizeof(uint16_t));
+			rc = settings_nvs_namecnt_write(cf);
 			if (rc < 0) {
 				/* Error: can't to store
 				 * the largest name ID in use.
@@ -182,29 +336,27 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			}
 		}
 
-		if (delete) {
-			rc = nvs_delete(&cf->cf_nvs, name_id);
-
-			if (rc >= 0) {
-				rc = nvs_delete(&cf->cf_nvs, name_id +
-					NVS_NAME_ID_OFFSET);
-			}
+		rc = nvs_delete(&cf->cf_nvs, name_id);
 
-			if (rc < 0) {
-				return rc;
-			}
+		if (rc >= 0) {
+			rc = nvs_delete(&cf->cf_nvs, name_id +
+				NVS_NAME_ID_OFFSET);
+		}
 
-			return 0;
+		if (rc < 0) {
+			return rc;
 		}
-		write_name_id = name_id;
-		write_name = false;
-		break;
-	}
 
-	if (delete) {
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		settings_nvs_index_set(cf, name_id, 0U);
+#endif
 		return 0;
 	}
 
+	if (!write_name) {
+		write_name_id = name_id;
+	}
+
 	/* No free IDs left. */
 	if (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
 		return -ENOMEM;
@@ -220,13 +372,17 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		if (rc < 0) {
 			return rc;
 		}
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		settings_nvs_index_set(cf, write_name_id,
+				       settings_nvs_name_hash(name,
+							      strlen(name)));
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
 		cf->last_name_id = write_name_id;
-		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
-			       sizeof(uint16_t));
+		rc = settings_nvs_namecnt_write(cf);
 	}
 
 	if (rc < 0) {
@@ -247,6 +403,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	cf->name_index_valid = false;
+#endif
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
@@ -255,6 +415,16 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+	/* Names stored during an export operation that was interrupted before
+	 * its end follow the stored largest name id.
+	 */
+	while (cf->last_name_id + 1 < NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET &&
+	       nvs_read(&cf->cf_nvs, cf->last_name_id + 1, &last_name_id,
+			sizeof(last_name_id)) > 0) {
+		cf->last_name_id++;
+	}
+	cf->save_in_progress = false;
+
 	LOG_DBG("Initialized");
 	return 0;
 }
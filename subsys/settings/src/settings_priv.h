@@ -58,6 +58,22 @@ struct settings_line_dup_check_arg {
 	int is_dup;
 };
 
+#ifdef CONFIG_SETTINGS_BATCH
+/* Name of the journal entry holding the changes of a batch being committed */
+#define SETTINGS_BATCH_NAME ".batch"
+
+/* A change queued in a batch is stored as this header followed by the name,
+ * without the terminating '\0', and the value. A val_len of 0 is a delete.
+ */
+struct settings_batch_rec {
+	uint16_t name_len;
+	uint16_t val_len;
+};
+
+/* Apply the changes of a journal entry left by an interrupted commit */
+int settings_batch_recover(void);
+#endif
+
 #ifdef CONFIG_SETTINGS_ENCODE_LEN
 /* in storage line contex */
 struct line_entry_ctx {
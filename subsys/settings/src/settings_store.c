@@ -24,6 +24,256 @@ sys_slist_t settings_load_srcs;
 struct settings_store *settings_save_dst;
 extern struct k_mutex settings_lock;
 
+#if defined(CONFIG_SETTINGS_BATCH)
+/* Changes queued since settings_batch_begin(), see settings_batch_rec */
+static uint8_t batch_buf[CONFIG_SETTINGS_BATCH_BUF_SIZE];
+static size_t batch_len;
+static bool batch_open;
+
+static size_t settings_batch_rec_size(size_t off)
+{
+	struct settings_batch_rec rec;
+
+	memcpy(&rec, &batch_buf[off], sizeof(rec));
+
+	return sizeof(rec) + rec.name_len + rec.val_len;
+}
+
+/* Offset of the queued change of name, batch_len if there is none */
+static size_t settings_batch_find(const char *name, size_t name_len)
+{
+	struct settings_batch_rec rec;
+	size_t off;
+
+	for (off = 0; off < batch_len; off += settings_batch_rec_size(off)) {
+		memcpy(&rec, &batch_buf[off], sizeof(rec));
+
+		if (rec.name_len == name_len &&
+		    !memcmp(&batch_buf[off + sizeof(rec)], name, name_len)) {
+			break;
+		}
+	}
+
+	return off;
+}
+
+/* Queue a change in place of any queued change of the same name */
+static int settings_batch_queue(const char *name, const void *value,
+				size_t val_len)
+{
+	struct settings_batch_rec rec = {
+		.name_len = strlen(name),
+		.val_len = val_len,
+	};
+	size_t off, size = 0;
+
+	if (rec.name_len > SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN ||
+	    val_len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	off = settings_batch_find(name, rec.name_len);
+	if (off < batch_len) {
+		size = settings_batch_rec_size(off);
+	}
+
+	if (batch_len - size + sizeof(rec) + rec.name_len + val_len >
+	    sizeof(batch_buf)) {
+		return -ENOMEM;
+	}
+
+	if (size) {
+		memmove(&batch_buf[off], &batch_buf[off + size],
+			batch_len - off - size);
+		batch_len -= size;
+	}
+
+	memcpy(&batch_buf[batch_len], &rec, sizeof(rec));
+	batch_len += sizeof(rec);
+	memcpy(&batch_buf[batch_len], name, rec.name_len);
+	batch_len += rec.name_len;
+	if (val_len) {
+		memcpy(&batch_buf[batch_len], value, val_len);
+		batch_len += val_len;
+	}
+
+	return 0;
+}
+
+/* Save the changes queued in batch_buf, within a single export operation of
+ * the back-end.
+ */
+static int settings_batch_apply(struct settings_store *cs)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	struct settings_batch_rec rec;
+	size_t off = 0;
+	int rc = 0;
+	int rc2;
+
+	if (cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	while (!rc && off + sizeof(rec) <= batch_len) {
+		memcpy(&rec, &batch_buf[off], sizeof(rec));
+		off += sizeof(rec);
+
+		if (rec.name_len >= sizeof(name) ||
+		    off + rec.name_len + rec.val_len > batch_len) {
+			rc = -EINVAL;
+			break;
+		}
+
+		memcpy(name, &batch_buf[off], rec.name_len);
+		name[rec.name_len] = '\0';
+		off += rec.name_len;
+
+		rc = cs->cs_itf->csi_save(cs, name,
+					  rec.val_len ?
+					  (char *)&batch_buf[off] : NULL,
+					  rec.val_len);
+		off += rec.val_len;
+	}
+
+	if (cs->cs_itf->csi_save_end) {
+		rc2 = cs->cs_itf->csi_save_end(cs);
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	return rc;
+}
+
+int settings_batch_begin(void)
+{
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (batch_open) {
+		k_mutex_unlock(&settings_lock);
+		return -EBUSY;
+	}
+
+	/* The lock is kept until the batch is committed or aborted */
+	batch_open = true;
+	batch_len = 0;
+
+	return 0;
+}
+
+int settings_batch_commit(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc = 0;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (!batch_open) {
+		k_mutex_unlock(&settings_lock);
+		return -EINVAL;
+	}
+
+	if (batch_len && settings_batch_rec_size(0) == batch_len) {
+		/* A single change is as atomic as it gets */
+		rc = settings_batch_apply(cs);
+	} else if (batch_len) {
+		/* Once the journal is stored, all the changes are applied,
+		 * if need be by settings_batch_recover() after a reset.
+		 */
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_BATCH_NAME,
+					  (char *)batch_buf, batch_len);
+		if (!rc) {
+			rc = settings_batch_apply(cs);
+		}
+		if (!rc) {
+			rc = cs->cs_itf->csi_save(cs, SETTINGS_BATCH_NAME,
+						  NULL, 0);
+		}
+	}
+
+	batch_open = false;
+	batch_len = 0;
+
+	k_mutex_unlock(&settings_lock);
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+void settings_batch_abort(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (batch_open) {
+		batch_open = false;
+		batch_len = 0;
+		k_mutex_unlock(&settings_lock);
+	}
+
+	k_mutex_unlock(&settings_lock);
+}
+
+static int settings_batch_journal_read(const char *key, size_t len,
+				       settings_read_cb read_cb, void *cb_arg,
+				       void *param)
+{
+	ssize_t rc;
+
+	ARG_UNUSED(param);
+
+	/* Only the journal itself, not a name below it */
+	if (key) {
+		return 0;
+	}
+
+	if (len > sizeof(batch_buf)) {
+		LOG_ERR("Settings batch journal too long (%zu)", len);
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, batch_buf, len);
+	batch_len = (rc > 0) ? rc : 0;
+
+	return 0;
+}
+
+int settings_batch_recover(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc = 0;
+
+	if (!cs) {
+		return 0;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	batch_len = 0;
+	(void)settings_load_subtree_direct(SETTINGS_BATCH_NAME,
+					   settings_batch_journal_read, NULL);
+
+	if (batch_len) {
+		LOG_WRN("Applying interrupted settings batch");
+
+		rc = settings_batch_apply(cs);
+		if (!rc) {
+			rc = cs->cs_itf->csi_save(cs, SETTINGS_BATCH_NAME,
+						  NULL, 0);
+		}
+		batch_len = 0;
+	}
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 void settings_src_register(struct settings_store *cs)
 {
 	sys_slist_append(&settings_load_srcs, &cs->cs_next);
@@ -103,6 +353,15 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#if defined(CONFIG_SETTINGS_BATCH)
+	/* Only the thread that opened the batch gets past the lock */
+	if (batch_open) {
+		rc = settings_batch_queue(name, value, val_len);
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+#endif
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -126,6 +385,8 @@ int settings_save(void)
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
 	if (cs->cs_itf->csi_save_start) {
 		cs->cs_itf->csi_save_start(cs);
 	}
@@ -155,6 +416,8 @@ int settings_save(void)
 	if (cs->cs_itf->csi_save_end) {
 		cs->cs_itf->csi_save_end(cs);
 	}
+
+	k_mutex_unlock(&settings_lock);
 	return rc;
 }
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <irq_offload.h>
+
+/* Wakeup latency of a thread waiting for any of 8 conditions, kept in
+ * one event object or in 8 poll signals.  See README.rst.
+ */
+
+#define NUM_CONDS 8
+#define NUM_WAKEUPS 5000
+#define STACK_SIZE 1024
+
+K_EVENT_DEFINE(bench_event);
+static struct k_poll_signal signals[NUM_CONDS];
+static struct k_poll_event poll_events[NUM_CONDS];
+
+K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static volatile uint32_t t_set;
+static uint64_t total_cycles;
+static uint32_t max_cycles;
+
+static void record(void)
+{
+	uint32_t dt = k_cycle_get_32() - t_set;
+
+	total_cycles += dt;
+	max_cycles = MAX(max_cycles, dt);
+}
+
+static void event_waiter(void)
+{
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		(void)k_event_wait(&bench_event, BIT_MASK(NUM_CONDS), true,
+				   K_FOREVER);
+		record();
+	}
+}
+
+static void event_set(uint32_t cond)
+{
+	k_event_set(&bench_event, BIT(cond));
+}
+
+static void poll_waiter(void)
+{
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		int cond;
+
+		(void)k_poll(poll_events, NUM_CONDS, K_FOREVER);
+		for (cond = 0; cond < NUM_CONDS; cond++) {
+			if (poll_events[cond].state != K_POLL_STATE_NOT_READY) {
+				break;
+			}
+		}
+		record();
+
+		k_poll_signal_reset(&signals[cond]);
+		poll_events[cond].state = K_POLL_STATE_NOT_READY;
+	}
+}
+
+static void poll_set(uint32_t cond)
+{
+	(void)k_poll_signal_raise(&signals[cond], 0);
+}
+
+struct variant {
+	const char *name;
+	void (*wait)(void);
+	void (*set)(uint32_t cond);
+};
+
+static const struct variant variants[] = {
+	{ "k_event", event_waiter, event_set },
+	{ "k_poll", poll_waiter, poll_set },
+};
+
+static const struct variant *cur;
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	cur->wait();
+}
+
+static void isr_set(const void *arg)
+{
+	t_set = k_cycle_get_32();
+	cur->set(POINTER_TO_UINT(arg));
+}
+
+static void run(const struct variant *v, bool from_isr)
+{
+	cur = v;
+	total_cycles = 0U;
+	max_cycles = 0U;
+
+	/* The waiter preempts the setter as soon as it is woken up */
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter_fn,
+			NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()) - 1, 0,
+			K_NO_WAIT);
+
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		uint32_t cond = i % NUM_CONDS;
+
+		if (from_isr) {
+			irq_offload(isr_set, UINT_TO_POINTER(cond));
+		} else {
+			t_set = k_cycle_get_32();
+			v->set(cond);
+		}
+	}
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	printk("%-7s %-6s avg %6u max %6u cycles\n", v->name,
+	       from_isr ? "isr" : "thread",
+	       (uint32_t)(total_cycles / NUM_WAKEUPS), max_cycles);
+}
+
+void main(void)
+{
+	for (int i = 0; i < NUM_CONDS; i++) {
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&poll_events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(variants); i++) {
+		run(&variants[i], false);
+	}
+	for (int i = 0; i < ARRAY_SIZE(variants); i++) {
+		run(&variants[i], true);
+	}
+	printk("fin\n");
+}
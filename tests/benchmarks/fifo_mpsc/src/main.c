@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Many-producers, one-consumer FIFO throughput.  The same workload
+ * runs against a k_fifo and a k_fifo_mpsc through a pair of small
+ * wrappers, so the numbers only differ by the FIFO implementation.
+ */
+
+#define MAX_PRODUCERS (2 * CONFIG_MP_NUM_CPUS)
+#define PRODUCER_ITEMS 32
+#define ISR_ITEMS 64
+#define ISR_BURST 8
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+
+struct item {
+	void *reserved;		/* for the FIFO's use */
+	atomic_t busy;
+};
+
+struct fifo_ops {
+	const char *name;
+	void (*put)(void *data);
+	void *(*get)(k_timeout_t timeout);
+};
+
+static K_FIFO_DEFINE(fifo);
+static K_FIFO_MPSC_DEFINE(fifo_mpsc);
+
+static const struct fifo_ops *ops;
+static atomic_t stop;
+
+static struct item items[MAX_PRODUCERS][PRODUCER_ITEMS];
+static struct item isr_items[ISR_ITEMS];
+static uint32_t isr_next;
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_PRODUCERS, STACK_SIZE);
+static struct k_thread threads[MAX_PRODUCERS];
+
+static void fifo_put(void *data)
+{
+	k_fifo_put(&fifo, data);
+}
+
+static void *fifo_get(k_timeout_t timeout)
+{
+	return k_fifo_get(&fifo, timeout);
+}
+
+static void mpsc_put(void *data)
+{
+	k_fifo_mpsc_put(&fifo_mpsc, data);
+}
+
+static void *mpsc_get(k_timeout_t timeout)
+{
+	return k_fifo_mpsc_get(&fifo_mpsc, timeout);
+}
+
+static const struct fifo_ops all_ops[] = {
+	{ "k_fifo", fifo_put, fifo_get },
+	{ "k_fifo_mpsc", mpsc_put, mpsc_get },
+};
+
+/* Queues the item unless it is still in flight */
+static bool try_put(struct item *it)
+{
+	if (!atomic_cas(&it->busy, 0, 1)) {
+		return false;
+	}
+	ops->put(it);
+	return true;
+}
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	struct item *mine = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; !atomic_get(&stop); i = (i + 1) % PRODUCER_ITEMS) {
+		if (!try_put(&mine[i])) {
+			k_yield();
+		}
+	}
+}
+
+static void isr_producer(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	for (int i = 0; i < ISR_BURST; i++) {
+		if (!try_put(&isr_items[isr_next])) {
+			break;
+		}
+		isr_next = (isr_next + 1) % ISR_ITEMS;
+	}
+}
+
+static K_TIMER_DEFINE(isr_timer, isr_producer, NULL);
+
+static void consume(struct item *it)
+{
+	atomic_clear(&it->busy);
+}
+
+static uint32_t run(int nprod)
+{
+	uint32_t count = 0U;
+
+	atomic_clear(&stop);
+	for (int i = 0; i < nprod; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				producer_fn, items[i], NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+	k_timer_start(&isr_timer, K_TICKS(1), K_TICKS(1));
+
+	int64_t start = k_uptime_get();
+
+	while (k_uptime_get() - start < RUN_MS) {
+		struct item *it = ops->get(K_MSEC(10));
+
+		if (it != NULL) {
+			consume(it);
+			count++;
+		}
+	}
+
+	int64_t ms = k_uptime_get() - start;
+
+	atomic_set(&stop, 1);
+	k_timer_stop(&isr_timer);
+	for (int i = 0; i < nprod; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	/* Drain and reset for the next round */
+	for (struct item *it; (it = ops->get(K_NO_WAIT)) != NULL; ) {
+		consume(it);
+	}
+
+	return (uint32_t)(count * 1000ULL / ms);
+}
+
+void main(void)
+{
+	/* The consumer runs at a higher priority than the producers,
+	 * like an RX or log processing thread would
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	for (int i = 0; i < ARRAY_SIZE(all_ops); i++) {
+		ops = &all_ops[i];
+		for (int n = 1; n <= MAX_PRODUCERS; n *= 2) {
+			printk("%-11s producers %2d items/s %8u\n",
+			       ops->name, n, run(n));
+		}
+	}
+	printk("fin\n");
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* k_heap small-block benchmark.  Every worker owns a window of live
+ * blocks and replaces a random one per iteration, so the heap sees a
+ * steady mix of frees and allocations of power-law distributed sizes
+ * from all workers at once.  The run is repeated on a heap too small
+ * for all windows, where allocations fail and drain the caches.
+ */
+
+#define HEAP_SIZE (64 * 1024)
+#define SMALL_HEAP_SIZE (4 * 1024)
+#define WINDOW 64
+#define ITERATIONS 20000
+#define STACK_SIZE 1024
+#define NUM_WORKERS CONFIG_MP_NUM_CPUS
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+K_HEAP_DEFINE(small_heap, SMALL_HEAP_SIZE);
+
+K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS];
+
+static K_SEM_DEFINE(start_sem, 0, NUM_WORKERS);
+static K_SEM_DEFINE(done_sem, 0, NUM_WORKERS);
+
+struct worker {
+	struct k_heap *heap;
+	void *live[WINDOW];
+	uint32_t rand_state;
+	uint32_t max_alloc_cycles;
+	uint32_t max_free_cycles;
+	uint32_t failures;
+};
+
+static struct worker workers[NUM_WORKERS];
+
+static uint32_t rand32(struct worker *w)
+{
+	w->rand_state = w->rand_state * 1103515245U + 12345U;
+	return w->rand_state >> 1;
+}
+
+static size_t rand_size(struct worker *w)
+{
+	uint32_t r = rand32(w);
+
+	/* Halve the odds for every doubling of the size range */
+	return (1 + (r & 0xf)) << __builtin_ctz((r >> 4) | BIT(6));
+}
+
+static void *timed_alloc(struct worker *w, size_t bytes)
+{
+	uint32_t t0 = k_cycle_get_32();
+	void *mem = k_heap_alloc(w->heap, bytes, K_NO_WAIT);
+
+	w->max_alloc_cycles = MAX(w->max_alloc_cycles,
+				  k_cycle_get_32() - t0);
+	if (mem == NULL) {
+		w->failures++;
+	}
+	return mem;
+}
+
+static void timed_free(struct worker *w, void *mem)
+{
+	uint32_t t0 = k_cycle_get_32();
+
+	k_heap_free(w->heap, mem);
+	w->max_free_cycles = MAX(w->max_free_cycles, k_cycle_get_32() - t0);
+}
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	struct worker *w = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (int i = 0; i < WINDOW; i++) {
+		w->live[i] = timed_alloc(w, rand_size(w));
+	}
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		int slot = rand32(w) % WINDOW;
+
+		timed_free(w, w->live[slot]);
+		w->live[slot] = timed_alloc(w, rand_size(w));
+	}
+
+	for (int i = 0; i < WINDOW; i++) {
+		timed_free(w, w->live[i]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void print_stats(struct k_heap *heap)
+{
+#ifdef CONFIG_K_HEAP_CACHE
+	struct k_heap_stats stats;
+
+	k_heap_stats_get(heap, &stats);
+	printk("  free %u allocated %u largest %u cached %u\n",
+	       (uint32_t)stats.free_bytes, (uint32_t)stats.allocated_bytes,
+	       (uint32_t)stats.largest_free_bytes,
+	       (uint32_t)stats.cached_bytes);
+	printk("  cache hits %u misses %u cached frees %u\n",
+	       stats.cache_hits, stats.cache_misses, stats.cached_frees);
+#endif
+}
+
+static void run(const char *name, struct k_heap *heap, int nthreads)
+{
+	uint32_t max_alloc = 0U, max_free = 0U, failures = 0U;
+
+	for (int i = 0; i < nthreads; i++) {
+		workers[i] = (struct worker) {
+			.heap = heap,
+			.rand_state = i + 1,
+		};
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker_fn, &workers[i], NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	int64_t start = k_uptime_get();
+
+	for (int i = 0; i < nthreads; i++) {
+		k_sem_give(&start_sem);
+	}
+	for (int i = 0; i < nthreads; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	int64_t ms = MAX(k_uptime_get() - start, 1);
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		max_alloc = MAX(max_alloc, workers[i].max_alloc_cycles);
+		max_free = MAX(max_free, workers[i].max_free_cycles);
+		failures += workers[i].failures;
+	}
+
+	uint64_t ops = (uint64_t)nthreads * (ITERATIONS + WINDOW);
+
+	printk("%s threads %d ops/s %u max alloc %u free %u cycles "
+	       "(%u failed)\n", name, nthreads,
+	       (uint32_t)(ops * MSEC_PER_SEC / ms), max_alloc, max_free,
+	       failures);
+	print_stats(heap);
+}
+
+void main(void)
+{
+	for (int n = 1; n <= NUM_WORKERS; n++) {
+		run("heap", &bench_heap, n);
+	}
+	for (int n = 1; n <= NUM_WORKERS; n++) {
+		run("small heap", &small_heap, n);
+	}
+	printk("fin\n");
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Per-message cost of moving bursts of small records through k_msgq
+ * and k_pipe one at a time versus with the batched calls.  See
+ * README.rst.
+ */
+
+#define REC_SIZE 16
+#define MAX_BURST 64
+#define NUM_MSGS (100 * MAX_BURST)
+#define STACK_SIZE 1024
+
+struct record {
+	uint32_t words[REC_SIZE / sizeof(uint32_t)];
+};
+
+K_MSGQ_DEFINE(bench_msgq, REC_SIZE, MAX_BURST, 4);
+K_PIPE_DEFINE(bench_pipe, MAX_BURST * REC_SIZE, 4);
+
+K_THREAD_STACK_DEFINE(rx_stack, STACK_SIZE);
+static struct k_thread rx_thread;
+
+static struct record tx_recs[MAX_BURST];
+static struct record rx_recs[MAX_BURST];
+static struct k_pipe_vec tx_vec[MAX_BURST];
+static struct k_pipe_vec rx_vec[MAX_BURST];
+
+static void msgq_send(int burst, bool batch)
+{
+	if (!batch) {
+		for (int i = 0; i < burst; i++) {
+			(void)k_msgq_put(&bench_msgq, &tx_recs[i], K_FOREVER);
+		}
+		return;
+	}
+
+	/* A batch stops short when the queue fills up */
+	for (int n = 0; n < burst; ) {
+		n += k_msgq_put_many(&bench_msgq, &tx_recs[n], burst - n,
+				     K_FOREVER);
+	}
+}
+
+static int msgq_recv(int burst, bool batch)
+{
+	if (!batch) {
+		for (int i = 0; i < burst; i++) {
+			(void)k_msgq_get(&bench_msgq, &rx_recs[i], K_FOREVER);
+		}
+		return burst;
+	}
+
+	return k_msgq_get_many(&bench_msgq, rx_recs, burst, K_FOREVER);
+}
+
+static void pipe_send(int burst, bool batch)
+{
+	size_t bytes;
+
+	if (!batch) {
+		for (int i = 0; i < burst; i++) {
+			(void)k_pipe_put(&bench_pipe, &tx_recs[i], REC_SIZE,
+					 &bytes, REC_SIZE, K_FOREVER);
+		}
+		return;
+	}
+
+	for (int n = 0; n < burst; ) {
+		n += k_pipe_put_vec(&bench_pipe, &tx_vec[n], burst - n,
+				    &bytes, K_FOREVER);
+	}
+}
+
+static void pipe_recv(int burst, bool batch)
+{
+	size_t bytes;
+
+	if (!batch) {
+		for (int i = 0; i < burst; i++) {
+			(void)k_pipe_get(&bench_pipe, &rx_recs[i], REC_SIZE,
+					 &bytes, REC_SIZE, K_FOREVER);
+		}
+		return;
+	}
+
+	for (int n = 0; n < burst; ) {
+		n += k_pipe_get_vec(&bench_pipe, &rx_vec[n], burst - n,
+				    &bytes, K_FOREVER);
+	}
+}
+
+static uint32_t msgq_local(int burst, bool batch)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_MSGS; i += burst) {
+		msgq_send(burst, batch);
+		(void)msgq_recv(burst, batch);
+	}
+
+	return (k_cycle_get_32() - start) / NUM_MSGS;
+}
+
+static void rx_fn(void *p1, void *p2, void *p3)
+{
+	int burst = POINTER_TO_INT(p1);
+	bool batch = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (int n = 0; n < NUM_MSGS; ) {
+		n += msgq_recv(burst, batch);
+	}
+}
+
+/* The receiver has a higher priority than the sender and blocks on
+ * the empty queue, so every wakeup also costs a context switch.
+ */
+static uint32_t msgq_threads(int burst, bool batch)
+{
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_create(&rx_thread, rx_stack, STACK_SIZE, rx_fn,
+			INT_TO_POINTER(burst), INT_TO_POINTER(batch), NULL,
+			k_thread_priority_get(k_current_get()) - 1, 0,
+			K_NO_WAIT);
+
+	for (int i = 0; i < NUM_MSGS; i += burst) {
+		msgq_send(burst, batch);
+	}
+	k_thread_join(&rx_thread, K_FOREVER);
+
+	return (k_cycle_get_32() - start) / NUM_MSGS;
+}
+
+static uint32_t pipe_local(int burst, bool batch)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_MSGS; i += burst) {
+		pipe_send(burst, batch);
+		pipe_recv(burst, batch);
+	}
+
+	return (k_cycle_get_32() - start) / NUM_MSGS;
+}
+
+struct scenario {
+	const char *name;
+	uint32_t (*run)(int burst, bool batch);
+};
+
+static const struct scenario scenarios[] = {
+	{ "msgq local  ", msgq_local },
+	{ "msgq threads", msgq_threads },
+	{ "pipe local  ", pipe_local },
+};
+
+void main(void)
+{
+	for (int i = 0; i < MAX_BURST; i++) {
+		tx_recs[i].words[0] = i;
+		tx_vec[i] = (struct k_pipe_vec) { &tx_recs[i], REC_SIZE };
+		rx_vec[i] = (struct k_pipe_vec) { &rx_recs[i], REC_SIZE };
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(scenarios); i++) {
+		const struct scenario *s = &scenarios[i];
+
+		for (int burst = 1; burst <= MAX_BURST; burst *= 2) {
+			printk("%s burst %2d %6u cycles/msg %6u cycles/msg\n",
+			       s->name, burst, s->run(burst, false),
+			       s->run(burst, true));
+		}
+	}
+	printk("fin\n");
+}
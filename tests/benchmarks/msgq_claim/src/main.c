@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Copy versus claim k_msgq benchmark with sensor-record sized
+ * messages.  See README.rst.
+ */
+
+#define MSG_WORDS 64
+#define MSG_SIZE (MSG_WORDS * sizeof(uint32_t))
+#define QUEUE_LEN 16
+#define NUM_MSGS 10000
+#define STACK_SIZE 1024
+
+struct record {
+	uint32_t words[MSG_WORDS];
+};
+
+K_MSGQ_DEFINE(bench_msgq, MSG_SIZE, QUEUE_LEN, 4);
+
+K_THREAD_STACK_DEFINE(rx_stack, STACK_SIZE);
+static struct k_thread rx_thread;
+
+static volatile uint32_t checksum;
+
+static void build(struct record *rec, uint32_t seq)
+{
+	for (int i = 0; i < MSG_WORDS; i++) {
+		rec->words[i] = seq + i;
+	}
+}
+
+static void consume(const struct record *rec)
+{
+	uint32_t sum = 0U;
+
+	for (int i = 0; i < MSG_WORDS; i++) {
+		sum += rec->words[i];
+	}
+	checksum += sum;
+}
+
+static void send_copy(uint32_t seq)
+{
+	struct record rec;
+
+	build(&rec, seq);
+	(void)k_msgq_put(&bench_msgq, &rec, K_FOREVER);
+}
+
+static void recv_copy(void)
+{
+	struct record rec;
+
+	(void)k_msgq_get(&bench_msgq, &rec, K_FOREVER);
+	consume(&rec);
+}
+
+static void send_claim(uint32_t seq)
+{
+	void *slot;
+
+	(void)k_msgq_put_claim(&bench_msgq, &slot, K_FOREVER);
+	build(slot, seq);
+	k_msgq_put_commit(&bench_msgq);
+}
+
+static void recv_claim(void)
+{
+	void *slot;
+
+	(void)k_msgq_get_claim(&bench_msgq, &slot, K_FOREVER);
+	consume(slot);
+	k_msgq_get_release(&bench_msgq);
+}
+
+struct variant {
+	const char *name;
+	void (*send)(uint32_t seq);
+	void (*recv)(void);
+};
+
+static const struct variant variants[] = {
+	{ "copy", send_copy, recv_copy },
+	{ "claim", send_claim, recv_claim },
+};
+
+static void rx_fn(void *p1, void *p2, void *p3)
+{
+	const struct variant *v = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		v->recv();
+	}
+}
+
+static uint32_t run_local(const struct variant *v)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		v->send(i);
+		v->recv();
+	}
+
+	return (k_cycle_get_32() - start) / NUM_MSGS;
+}
+
+static uint32_t run_threads(const struct variant *v)
+{
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_create(&rx_thread, rx_stack, STACK_SIZE, rx_fn,
+			(void *)v, NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0,
+			K_NO_WAIT);
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		v->send(i);
+	}
+	k_thread_join(&rx_thread, K_FOREVER);
+
+	return (k_cycle_get_32() - start) / NUM_MSGS;
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(variants); i++) {
+		const struct variant *v = &variants[i];
+
+		printk("%-5s local   %6u cycles/msg\n", v->name, run_local(v));
+		printk("%-5s threads %6u cycles/msg\n", v->name,
+		       run_threads(v));
+	}
+	printk("fin\n");
+}
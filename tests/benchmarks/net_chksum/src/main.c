@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#include "net_private.h"
+
+/* Cost of the UDP checksum of packets of growing size, with a 16-bit
+ * loop and with the stack's implementation.  See README.rst.
+ */
+
+#define MAX_SIZE 1500
+#define NUM_RUNS 1000
+
+static const size_t sizes[] = { 64, 128, 256, 512, 1024, 1500 };
+
+static uint8_t frame[MAX_SIZE];
+
+/* The loop net_calc_chksum() used before */
+static uint16_t ref_sum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len - 1;
+	uint16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static uint16_t ref_chksum_udp(struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *ip = NET_IPV4_HDR(pkt);
+	size_t len = net_pkt_get_len(pkt) - NET_IPV4H_LEN;
+	uint16_t sum;
+
+	sum = ref_sum(len + IPPROTO_UDP, (uint8_t *)&ip->src,
+		      2 * sizeof(struct in_addr));
+	sum = ref_sum(sum, (uint8_t *)ip + NET_IPV4H_LEN, len);
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+static struct net_pkt *udp_pkt(size_t size)
+{
+	struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)frame;
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)(ip + 1);
+	struct net_pkt *pkt;
+
+	for (size_t i = 0; i < size; i++) {
+		frame[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	ip->vhl = 0x45;
+	ip->len = htons(size);
+	ip->proto = IPPROTO_UDP;
+	ip->src.s_addr = htonl(0xc0000201);
+	ip->dst.s_addr = htonl(0xc0000202);
+	udp->src_port = htons(4242);
+	udp->dst_port = htons(4243);
+	udp->len = htons(size - NET_IPV4H_LEN);
+	udp->chksum = 0U;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), size,
+					AF_UNSPEC, 0, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	if (net_pkt_write(pkt, frame, size) < 0 || pkt->buffer->frags) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static bool verify(void)
+{
+	struct net_pkt *pkt;
+	bool ok;
+
+	for (size_t size = NET_IPV4H_LEN + NET_UDPH_LEN; size <= MAX_SIZE;
+	     size++) {
+		pkt = udp_pkt(size);
+		if (!pkt) {
+			printk("cannot allocate %zu bytes\n", size);
+			return false;
+		}
+
+		ok = net_calc_chksum(pkt, IPPROTO_UDP) == ref_chksum_udp(pkt);
+		net_pkt_unref(pkt);
+
+		if (!ok) {
+			printk("checksum mismatch, size %zu\n", size);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void measure(size_t size)
+{
+	uint32_t start, ref_cycles, cycles;
+	volatile uint16_t chksum;
+	struct net_pkt *pkt;
+
+	pkt = udp_pkt(size);
+	if (!pkt) {
+		return;
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_RUNS; i++) {
+		chksum = ref_chksum_udp(pkt);
+	}
+	ref_cycles = (k_cycle_get_32() - start) / NUM_RUNS;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_RUNS; i++) {
+		chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	}
+	cycles = (k_cycle_get_32() - start) / NUM_RUNS;
+
+	printk("size %4zu %6u cycles 16-bit %6u cycles\n", size, ref_cycles,
+	       cycles);
+
+	net_pkt_unref(pkt);
+}
+
+static bool measure_incremental(void)
+{
+	struct net_udp_hdr *udp;
+	struct net_pkt *pkt;
+	uint16_t old_port, new_port;
+	uint32_t start;
+	bool ok;
+
+	pkt = udp_pkt(MAX_SIZE);
+	if (!pkt) {
+		return false;
+	}
+
+	udp = (struct net_udp_hdr *)(pkt->buffer->data + NET_IPV4H_LEN);
+	udp->chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	old_port = udp->dst_port;
+	new_port = htons(ntohs(old_port) + 1);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_RUNS; i++) {
+		/* Back and forth, so that the packet ends up modified once */
+		udp->chksum = net_chksum_update16(udp->chksum, old_port,
+						  new_port);
+		udp->chksum = net_chksum_update16(udp->chksum, new_port,
+						  old_port);
+	}
+	printk("incremental %u cycles\n",
+	       (k_cycle_get_32() - start) / (2 * NUM_RUNS));
+
+	udp->chksum = net_chksum_update16(udp->chksum, old_port, new_port);
+	udp->dst_port = new_port;
+
+	/* A valid checksum adds up to zero */
+	ok = net_calc_chksum(pkt, IPPROTO_UDP) == 0U;
+	net_pkt_unref(pkt);
+
+	if (!ok) {
+		printk("incremental update mismatch\n");
+	}
+
+	return ok;
+}
+
+void main(void)
+{
+	if (!verify()) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		measure(sizes[i]);
+	}
+
+	if (!measure_incremental()) {
+		return;
+	}
+
+	printk("fin\n");
+}
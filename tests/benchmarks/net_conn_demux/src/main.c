@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#include "connection.h"
+
+/* Cost of finding the handler of a received packet among a growing
+ * number of connections.  See README.rst.
+ */
+
+#define MAX_CONNS 256
+#define NUM_LOOKUPS 1000
+#define LOCAL_PORT 4242
+#define LISTEN_PORT 5000
+#define REMOTE_PORT_BASE 10000
+
+static const struct in_addr local_ip = { { { 192, 0, 2, 1 } } };
+static const struct in_addr remote_ip = { { { 198, 51, 100, 1 } } };
+static const struct in_addr other_ip = { { { 198, 51, 100, 2 } } };
+
+static uint32_t num_matches;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* The packet is kept for the next lookup */
+	num_matches++;
+
+	return NET_OK;
+}
+
+static void conn_add(int i)
+{
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = remote_ip,
+	};
+	int ret;
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET,
+				(struct sockaddr *)&remote, NULL,
+				REMOTE_PORT_BASE + i, LOCAL_PORT,
+				conn_cb, NULL, NULL);
+	__ASSERT(ret == 0, "net_conn_register() failed (%d)", ret);
+}
+
+static uint32_t lookup(struct net_pkt *pkt, const struct in_addr *src,
+		       uint16_t src_port, uint16_t dst_port)
+{
+	struct net_ipv4_hdr ipv4 = { 0 };
+	struct net_udp_hdr udp = { 0 };
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	uint32_t start, matches = num_matches;
+
+	net_ipaddr_copy(&ipv4.src, src);
+	net_ipaddr_copy(&ipv4.dst, &local_ip);
+	udp.src_port = htons(src_port);
+	udp.dst_port = htons(dst_port);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_LOOKUPS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+	start = k_cycle_get_32() - start;
+
+	__ASSERT(num_matches - matches == NUM_LOOKUPS, "handler not found");
+
+	return start / NUM_LOOKUPS;
+}
+
+void main(void)
+{
+	struct net_pkt *pkt;
+	int ret, n = 0;
+
+	pkt = net_pkt_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_iface(pkt, net_if_get_default());
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL, NULL, 0,
+				LISTEN_PORT, conn_cb, NULL, NULL);
+	__ASSERT(ret == 0, "net_conn_register() failed (%d)", ret);
+
+	for (int conns = 1; conns <= MAX_CONNS; conns *= 2) {
+		while (n < conns) {
+			conn_add(n++);
+		}
+
+		printk("%-10s conns %3d %6u cycles/lookup\n", "connected",
+		       conns, lookup(pkt, &remote_ip,
+				     REMOTE_PORT_BASE + conns - 1,
+				     LOCAL_PORT));
+		printk("%-10s conns %3d %6u cycles/lookup\n", "listener",
+		       conns, lookup(pkt, &other_ip, REMOTE_PORT_BASE,
+				     LISTEN_PORT));
+	}
+
+	net_pkt_unref(pkt);
+	printk("fin\n");
+}
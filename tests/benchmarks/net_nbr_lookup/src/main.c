@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+
+#include "arp.h"
+#include "ipv6.h"
+#include "nbr.h"
+
+/* Cost of finding the link layer address of a neighbor among a growing
+ * number of known neighbors.  See README.rst.
+ */
+
+#define MAX_NBRS 128
+#define NUM_ROUNDS 10
+
+static const struct in_addr my_ipv4 = { { { 192, 0, 2, 1 } } };
+static const struct in_addr netmask = { { { 255, 255, 0, 0 } } };
+
+/* The driver drops the frames, ARP replies included */
+struct eth_drop_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+};
+
+static struct eth_drop_context eth_drop_data = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+};
+
+static void eth_drop_iface_init(struct net_if *iface)
+{
+	struct eth_drop_context *ctx = net_if_get_device(iface)->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_drop_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static int eth_drop_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct ethernet_api eth_drop_api = {
+	.iface_api.init = eth_drop_iface_init,
+	.send = eth_drop_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_drop, "eth_drop", eth_drop_init,
+		    device_pm_control_nop, &eth_drop_data, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_drop_api, NET_ETH_MTU);
+
+static void nbr_ipv4(int i, struct in_addr *addr)
+{
+	net_ipaddr_copy(addr, &my_ipv4);
+	addr->s4_addr[3] = 10 + i;
+}
+
+static void nbr_ipv6(int i, struct in6_addr *addr)
+{
+	struct in6_addr prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0 } } };
+
+	net_ipaddr_copy(addr, &prefix);
+	UNALIGNED_PUT(htonl(0x1000 + i), &addr->s6_addr32[3]);
+}
+
+static void nbr_mac(int i, struct net_eth_addr *mac)
+{
+	static const struct net_eth_addr base = {
+		{ 0x00, 0x00, 0x5E, 0x00, 0x53, 0x00 }
+	};
+
+	*mac = base;
+	mac->addr[5] = 0x10 + i;
+}
+
+/* An ARP request from the neighbor, asking for our address, adds the
+ * neighbor to the ARP cache.
+ */
+static void arp_add(struct net_if *iface, int i)
+{
+	struct net_eth_hdr *eth_hdr;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(struct net_eth_hdr) +
+					   sizeof(struct net_arp_hdr),
+					   AF_UNSPEC, 0, K_FOREVER);
+
+	eth_hdr = (struct net_eth_hdr *)net_buf_add(pkt->buffer,
+						    sizeof(*eth_hdr));
+	(void)memset(&eth_hdr->dst, 0xff, sizeof(eth_hdr->dst));
+	nbr_mac(i, &eth_hdr->src);
+	eth_hdr->type = htons(NET_ETH_PTYPE_ARP);
+	net_buf_pull(pkt->buffer, sizeof(*eth_hdr));
+
+	arp_hdr = (struct net_arp_hdr *)net_buf_add(pkt->buffer,
+						    sizeof(*arp_hdr));
+	arp_hdr->hwtype = htons(NET_ARP_HTYPE_ETH);
+	arp_hdr->protocol = htons(NET_ETH_PTYPE_IP);
+	arp_hdr->hwlen = sizeof(struct net_eth_addr);
+	arp_hdr->protolen = sizeof(struct in_addr);
+	arp_hdr->opcode = htons(NET_ARP_REQUEST);
+	nbr_mac(i, &arp_hdr->src_hwaddr);
+	(void)memset(&arp_hdr->dst_hwaddr, 0, sizeof(arp_hdr->dst_hwaddr));
+	nbr_ipv4(i, &arp_hdr->src_ipaddr);
+	net_ipaddr_copy(&arp_hdr->dst_ipaddr, &my_ipv4);
+
+	if (net_arp_input(pkt, eth_hdr) != NET_OK) {
+		net_pkt_unref(pkt);
+		__ASSERT(false, "ARP request %d dropped", i);
+	}
+}
+
+static void ipv6_add(struct net_if *iface, int i)
+{
+	struct net_eth_addr mac;
+	struct net_linkaddr lladdr = {
+		.addr = mac.addr,
+		.len = sizeof(mac),
+		.type = NET_LINK_ETHERNET,
+	};
+	struct in6_addr addr;
+	struct net_nbr *nbr;
+
+	nbr_mac(i, &mac);
+	nbr_ipv6(i, &addr);
+
+	nbr = net_ipv6_nbr_add(iface, &addr, &lladdr, false,
+			       NET_IPV6_NBR_STATE_STATIC);
+	__ASSERT(nbr, "IPv6 neighbor %d not added", i);
+}
+
+static uint32_t arp_lookup(struct net_pkt *pkt, int nbrs)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	uint32_t start, cycles = 0U;
+	struct net_pkt *ret;
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		for (int i = 0; i < nbrs; i++) {
+			nbr_ipv4(i, &hdr->dst);
+
+			start = k_cycle_get_32();
+			ret = net_arp_prepare(pkt, &hdr->dst, NULL);
+			cycles += k_cycle_get_32() - start;
+
+			__ASSERT(ret == pkt, "ARP entry %d not found", i);
+		}
+	}
+
+	return cycles / (NUM_ROUNDS * nbrs);
+}
+
+static uint32_t ipv6_lookup(struct net_if *iface, int nbrs)
+{
+	uint32_t start, cycles = 0U;
+	struct in6_addr addr;
+	struct net_nbr *nbr;
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		for (int i = 0; i < nbrs; i++) {
+			nbr_ipv6(i, &addr);
+
+			start = k_cycle_get_32();
+			nbr = net_ipv6_nbr_lookup(iface, &addr);
+			cycles += k_cycle_get_32() - start;
+
+			__ASSERT(nbr, "IPv6 neighbor %d not found", i);
+		}
+	}
+
+	return cycles / (NUM_ROUNDS * nbrs);
+}
+
+void main(void)
+{
+	struct net_if *iface = eth_drop_data.iface;
+	struct net_if_addr *ifaddr;
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	int n = 0;
+
+	ifaddr = net_if_ipv4_addr_add(iface, (struct in_addr *)&my_ipv4,
+				      NET_ADDR_MANUAL, 0);
+	__ASSERT(ifaddr, "cannot add address");
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	/* The packet is kept for every lookup */
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_FOREVER);
+	hdr = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer, sizeof(*hdr));
+	net_ipaddr_copy(&hdr->src, &my_ipv4);
+
+	for (int nbrs = 8; nbrs <= MAX_NBRS; nbrs *= 2) {
+		while (n < nbrs) {
+			arp_add(iface, n);
+			ipv6_add(iface, n);
+			n++;
+		}
+
+		/* Let the TX thread drop the ARP replies */
+		k_sleep(K_MSEC(10));
+
+		printk("%-4s entries %3d %6u cycles/lookup\n", "arp", nbrs,
+		       arp_lookup(pkt, nbrs));
+		printk("%-4s entries %3d %6u cycles/lookup\n", "ipv6", nbrs,
+		       ipv6_lookup(iface, nbrs));
+	}
+
+	net_pkt_unref(pkt);
+	printk("fin\n");
+}
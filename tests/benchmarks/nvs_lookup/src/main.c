@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <stats/stats.h>
+#include <fs/nvs.h>
+
+/* Cost of reading and writing an NVS id among a growing number of ids
+ * stored in the flash simulator.  See README.rst.
+ */
+
+#define SECTOR_SIZE 4096
+#define SECTOR_COUNT 16
+#define MAX_ENTRIES 1024
+
+static struct nvs_fs fs = {
+	.sector_size = SECTOR_SIZE,
+	.sector_count = SECTOR_COUNT,
+	.offset = FLASH_AREA_OFFSET(storage),
+};
+
+static uint32_t *bytes_read;
+
+static int bytes_read_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	if (!strcmp(name, "bytes_read")) {
+		bytes_read = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static int read_all(int entries, uint32_t value)
+{
+	uint32_t start, cycles = 0U, bytes;
+	uint32_t data;
+	ssize_t len;
+
+	bytes = *bytes_read;
+
+	for (int id = 0; id < entries; id++) {
+		start = k_cycle_get_32();
+		len = nvs_read(&fs, id, &data, sizeof(data));
+		cycles += k_cycle_get_32() - start;
+
+		if (len != sizeof(data) || data != value) {
+			printk("read of id %d failed (%d)\n", id, (int)len);
+			return -1;
+		}
+	}
+
+	printk("entries %4d read %8u cycles %6u bytes ", entries,
+	       cycles / entries, (*bytes_read - bytes) / entries);
+
+	return 0;
+}
+
+/* Every write changes the data, unchanged data would not be written */
+static int write_all(int entries, uint32_t value)
+{
+	uint32_t start, cycles = 0U, bytes;
+	ssize_t len;
+
+	bytes = *bytes_read;
+
+	for (int id = 0; id < entries; id++) {
+		start = k_cycle_get_32();
+		len = nvs_write(&fs, id, &value, sizeof(value));
+		cycles += k_cycle_get_32() - start;
+
+		if (len != sizeof(value)) {
+			printk("write of id %d failed (%d)\n", id, (int)len);
+			return -1;
+		}
+	}
+
+	printk("write %8u cycles %6u bytes\n", cycles / entries,
+	       (*bytes_read - bytes) / entries);
+
+	return 0;
+}
+
+void main(void)
+{
+	const struct flash_area *fa;
+	uint32_t value = 0U;
+	ssize_t len;
+	int err, n = 0;
+
+	stats_walk(stats_group_find("flash_sim_stats"), bytes_read_find, NULL);
+	if (!bytes_read) {
+		printk("no flash simulator statistics\n");
+		return;
+	}
+
+	err = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (err == 0) {
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+	if (err == 0) {
+		err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	}
+	if (err) {
+		printk("storage setup failed (%d)\n", err);
+		return;
+	}
+
+	for (int entries = 16; entries <= MAX_ENTRIES; entries *= 2) {
+		/* The new ids get the data of the older ones */
+		while (n < entries) {
+			len = nvs_write(&fs, n, &value, sizeof(value));
+			if (len != sizeof(value)) {
+				printk("write of id %d failed (%d)\n", n,
+				       (int)len);
+				return;
+			}
+			n++;
+		}
+
+		if (read_all(entries, value) < 0 ||
+		    write_all(entries, ++value) < 0) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
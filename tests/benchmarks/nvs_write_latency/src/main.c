@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <fs/nvs.h>
+
+/* Distribution of the time spent in nvs_write() while the garbage
+ * collection keeps up with the writes.  See README.rst.
+ */
+
+#define SECTOR_SIZE 4096
+#define SECTOR_COUNT 8
+#define NUM_IDS 32
+#define NUM_WRITES 2000
+#define NUM_BUCKETS 24
+
+static struct nvs_fs fs = {
+	.sector_size = SECTOR_SIZE,
+	.sector_count = SECTOR_COUNT,
+	.offset = FLASH_AREA_OFFSET(storage),
+};
+
+static uint32_t latency[NUM_WRITES];
+static uint32_t buckets[NUM_BUCKETS];
+
+static void sort(uint32_t *v, int n)
+{
+	uint32_t t;
+	int j;
+
+	for (int i = 1; i < n; i++) {
+		t = v[i];
+		for (j = i; j > 0 && v[j - 1] > t; j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = t;
+	}
+}
+
+static void report(void)
+{
+	int b;
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		for (b = 0; b < NUM_BUCKETS - 1; b++) {
+			if (latency[i] < (2U << b)) {
+				break;
+			}
+		}
+		buckets[b]++;
+	}
+
+	sort(latency, NUM_WRITES);
+
+	printk("writes %d p50 %6u us p90 %6u us p99 %6u us max %6u us\n",
+	       NUM_WRITES, latency[NUM_WRITES / 2],
+	       latency[NUM_WRITES * 9 / 10], latency[NUM_WRITES * 99 / 100],
+	       latency[NUM_WRITES - 1]);
+
+	for (b = 0; b < NUM_BUCKETS; b++) {
+		if (buckets[b]) {
+			printk("< %8u us %4u writes\n", 2U << b, buckets[b]);
+		}
+	}
+}
+
+void main(void)
+{
+	const struct flash_area *fa;
+	uint32_t start, data[8];
+	ssize_t len;
+	int err;
+
+	err = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (err == 0) {
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+	if (err == 0) {
+		err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	}
+	if (err) {
+		printk("storage setup failed (%d)\n", err);
+		return;
+	}
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		/* Every write changes the data, unchanged data would not be
+		 * written
+		 */
+		for (int j = 0; j < ARRAY_SIZE(data); j++) {
+			data[j] = i;
+		}
+
+		start = k_cycle_get_32();
+		len = nvs_write(&fs, i % NUM_IDS, data, sizeof(data));
+		latency[i] = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		if (len != sizeof(data)) {
+			printk("write %d failed (%d)\n", i, (int)len);
+			return;
+		}
+
+		k_sleep(K_MSEC(2));
+	}
+
+	/* The last NUM_IDS writes hold the latest data of every id */
+	for (int i = NUM_WRITES - NUM_IDS; i < NUM_WRITES; i++) {
+		len = nvs_read(&fs, i % NUM_IDS, data, sizeof(data));
+		if (len != sizeof(data) || data[0] != i ||
+		    data[ARRAY_SIZE(data) - 1] != i) {
+			printk("read of id %d failed (%d)\n", i % NUM_IDS,
+			       (int)len);
+			return;
+		}
+	}
+
+	report();
+
+	printk("fin\n");
+}
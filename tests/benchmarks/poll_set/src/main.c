@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Cost of waiting for one active semaphore next to a growing number of
+ * idle ones, with k_poll() and with a poll set.  See README.rst.
+ */
+
+#define MAX_IDLE 128
+#define NUM_WAITS 1000
+#define STACK_SIZE 1024
+
+static struct k_sem active_sem;
+static struct k_sem idle_sems[MAX_IDLE];
+static struct k_poll_event events[MAX_IDLE + 1];
+static struct k_poll_set set;
+
+K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static void poll_waiter(int num_events)
+{
+	for (int i = 0; i < NUM_WAITS; i++) {
+		(void)k_poll(events, num_events, K_FOREVER);
+		(void)k_sem_take(&active_sem, K_NO_WAIT);
+		events[0].state = K_POLL_STATE_NOT_READY;
+	}
+}
+
+static void set_waiter(int num_events)
+{
+	struct k_poll_event *ready;
+
+	for (int i = 0; i < num_events; i++) {
+		k_poll_set_add(&set, &events[i]);
+	}
+
+	for (int i = 0; i < NUM_WAITS; i++) {
+		(void)k_poll_set_wait(&set, &ready, 1, K_FOREVER);
+		(void)k_sem_take(&active_sem, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < num_events; i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+}
+
+struct variant {
+	const char *name;
+	void (*wait)(int num_events);
+};
+
+static const struct variant variants[] = {
+	{ "k_poll", poll_waiter },
+	{ "k_poll_set", set_waiter },
+};
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	const struct variant *v = p1;
+
+	ARG_UNUSED(p3);
+
+	v->wait(POINTER_TO_INT(p2));
+}
+
+/* The waiter preempts the giver as soon as it is woken up */
+static uint32_t run(const struct variant *v, int num_idle)
+{
+	uint32_t start;
+
+	k_poll_set_init(&set);
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter_fn,
+			(void *)v, INT_TO_POINTER(num_idle + 1), NULL,
+			k_thread_priority_get(k_current_get()) - 1, 0,
+			K_NO_WAIT);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_WAITS; i++) {
+		k_sem_give(&active_sem);
+	}
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	return (k_cycle_get_32() - start) / NUM_WAITS;
+}
+
+void main(void)
+{
+	k_sem_init(&active_sem, 0, 1);
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &active_sem);
+	for (int i = 0; i < MAX_IDLE; i++) {
+		k_sem_init(&idle_sems[i], 0, 1);
+		k_poll_event_init(&events[i + 1], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &idle_sems[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(variants); i++) {
+		const struct variant *v = &variants[i];
+
+		for (int n = 0; n <= MAX_IDLE; n = (n == 0) ? 1 : n * 2) {
+			printk("%-10s idle %3d %6u cycles/wait\n", v->name,
+			       n, run(v, n));
+		}
+	}
+	printk("fin\n");
+}
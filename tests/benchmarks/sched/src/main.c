@@ -86,6 +86,91 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+/* Second phase: ready queue scaling.  N_QUEUED threads are created
+ * at priorities below main() and marked started without ever being
+ * allowed to run, then readied so that the run queue holds a given
+ * number of them.  Keeping that occupancy, each iteration removes
+ * one of them, readies it again and asks for the next thread to run,
+ * timing z_remove_thread_from_ready_q(), z_ready_thread() and
+ * z_get_next_ready_thread() (which runs next_up() on SMP; on
+ * uniprocessor next_up() runs inside the other two calls, via the
+ * ready queue cache update).
+ */
+#define N_QUEUED 128
+#define N_SCALE_RUNS 256
+
+static K_THREAD_STACK_ARRAY_DEFINE(queued_stacks, N_QUEUED, 256);
+static struct k_thread queued_threads[N_QUEUED];
+
+static const int queue_sizes[] = { 1, 8, 32, N_QUEUED };
+
+static void queued_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	k_panic();
+}
+
+static void scaling_bench(void)
+{
+	int main_prio = k_thread_priority_get(k_current_get());
+	int spread = K_LOWEST_APPLICATION_THREAD_PRIO - main_prio;
+
+	/* Stepping through the priorities by a prime keeps even the
+	 * first few threads far apart when many priorities are configured
+	 */
+	for (int i = 0; i < N_QUEUED; i++) {
+		k_thread_create(&queued_threads[i], queued_stacks[i],
+				K_THREAD_STACK_SIZEOF(queued_stacks[i]),
+				queued_fn, NULL, NULL, NULL,
+				main_prio + 1 + (i * 37) % spread, 0,
+				K_FOREVER);
+		z_mark_thread_as_started(&queued_threads[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(queue_sizes); i++) {
+		int n = queue_sizes[i];
+		uint64_t t_remove = 0U, t_ready = 0U, t_next = 0U;
+
+		for (int j = 0; j < n; j++) {
+			z_ready_thread(&queued_threads[j]);
+		}
+
+		for (int r = 0; r < N_SCALE_RUNS; r++) {
+			struct k_thread *th = &queued_threads[r % n];
+
+			stamp(UNPENDING);
+			z_remove_thread_from_ready_q(th);
+			stamp(UNPENDED_READYING);
+			z_ready_thread(th);
+			stamp(READIED_YIELDING);
+			(void)z_get_next_ready_thread();
+			stamp(YIELDED);
+
+			t_remove += stamps[UNPENDED_READYING] -
+				stamps[UNPENDING];
+			t_ready += stamps[READIED_YIELDING] -
+				stamps[UNPENDED_READYING];
+			t_next += stamps[YIELDED] - stamps[READIED_YIELDING];
+		}
+
+		for (int j = 0; j < n; j++) {
+			z_remove_thread_from_ready_q(&queued_threads[j]);
+		}
+
+		printk("queued %4d remove %4u ready %4u next %4u\n", n,
+		       (uint32_t)(t_remove / N_SCALE_RUNS),
+		       (uint32_t)(t_ready / N_SCALE_RUNS),
+		       (uint32_t)(t_next / N_SCALE_RUNS));
+	}
+
+	for (int i = 0; i < N_QUEUED; i++) {
+		k_thread_abort(&queued_threads[i]);
+	}
+}
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,5 +233,7 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+	scaling_bench();
 	printk("fin\n");
 }
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* SMP scheduler scaling benchmark.  For an increasing number of
+ * concurrently active thread pairs (one up to the number of CPUs) it
+ * measures, over a fixed interval, how many semaphore ping-pong
+ * handoffs and how many k_yield() calls the system as a whole
+ * completes per second.  With a perfectly scalable scheduler both
+ * numbers grow linearly with the number of pairs.
+ */
+
+#define MAX_PAIRS CONFIG_MP_NUM_CPUS
+#define STACK_SIZE 1024
+#define RUN_MS 1000
+#define WORKER_PRIO 4
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	uint32_t count[2];
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_PAIRS];
+static struct pair pairs[MAX_PAIRS];
+static volatile bool running;
+
+static void pinger(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		k_sem_give(&pair->pong);
+		k_sem_take(&pair->ping, K_FOREVER);
+		pair->count[0]++;
+	}
+	k_sem_give(&pair->pong);
+}
+
+static void ponger(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		k_sem_take(&pair->pong, K_FOREVER);
+		k_sem_give(&pair->ping);
+		pair->count[1]++;
+	}
+	k_sem_give(&pair->ping);
+}
+
+static void yielder(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		k_yield();
+		(*count)++;
+	}
+}
+
+static uint32_t run(int npairs, bool yield)
+{
+	uint64_t total = 0U;
+	int64_t start;
+
+	running = true;
+
+	for (int i = 0; i < npairs; i++) {
+		struct pair *pair = &pairs[i];
+
+		k_sem_init(&pair->ping, 0, 1);
+		k_sem_init(&pair->pong, 0, 1);
+		pair->count[0] = 0U;
+		pair->count[1] = 0U;
+
+		for (int j = 0; j < 2; j++) {
+			k_thread_entry_t fn = yield ? yielder
+				: (j == 0 ? pinger : ponger);
+			void *arg = yield ? (void *)&pair->count[j]
+				: (void *)pair;
+
+			k_thread_create(&threads[2 * i + j], stacks[2 * i + j],
+					STACK_SIZE, fn, arg, NULL, NULL,
+					WORKER_PRIO, 0, K_NO_WAIT);
+		}
+	}
+
+	start = k_uptime_get();
+	k_sleep(K_MSEC(RUN_MS));
+	running = false;
+
+	for (int i = 0; i < 2 * npairs; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < npairs; i++) {
+		total += pairs[i].count[0] + pairs[i].count[1];
+	}
+
+	return (total * 1000U) / (k_uptime_get() - start);
+}
+
+void main(void)
+{
+	/* Main runs above the workers so it can stop them on time */
+	k_thread_priority_set(k_current_get(), WORKER_PRIO - 1);
+
+	printk("CPUs %d, per-CPU run queues %s\n", CONFIG_MP_NUM_CPUS,
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "on" : "off");
+
+	for (int npairs = 1; npairs <= MAX_PAIRS; npairs++) {
+		uint32_t wakeups = run(npairs, false);
+		uint32_t yields = run(npairs, true);
+
+		printk("pairs %d wakeups/s %u yields/s %u\n",
+		       npairs, wakeups, yields);
+	}
+	printk("fin\n");
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <storage/flash_map.h>
+#include <stats/stats.h>
+#include <settings/settings.h>
+#include <settings/settings_fcb.h>
+
+#include "settings_priv.h"
+
+/* Boot time cost of loading the settings stored with the FCB back-end,
+ * among a growing number of stored settings.  See README.rst.
+ */
+
+#define SMALL_KEYS 10
+
+static const int sizes[] = { 100, 250, 500, 1000 };
+
+static struct flash_sector sectors[] = {
+	{ .fs_off = 0x0000, .fs_size = 0x4000 },
+	{ .fs_off = 0x4000, .fs_size = 0x4000 },
+	{ .fs_off = 0x8000, .fs_size = 0x4000 },
+	{ .fs_off = 0xc000, .fs_size = 0x4000 },
+};
+
+static struct settings_fcb cf;
+
+static uint32_t *bytes_read;
+static int loaded;
+
+static int bytes_read_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	if (!strcmp(name, "bytes_read")) {
+		bytes_read = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t value;
+
+	if (len != sizeof(value) || read_cb(cb_arg, &value, len) != len) {
+		return -EINVAL;
+	}
+
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+/* Register the back-end again, with nothing known about the storage */
+static int mount(void)
+{
+	int err;
+
+	sys_slist_init(&settings_load_srcs);
+	settings_save_dst = NULL;
+
+	(void)memset(&cf, 0, sizeof(cf));
+	cf.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf.cf_fcb.f_sectors = sectors;
+	cf.cf_fcb.f_sector_cnt = ARRAY_SIZE(sectors);
+
+	err = settings_fcb_src(&cf);
+	if (err == 0) {
+		err = settings_fcb_dst(&cf);
+	}
+	if (err == 0) {
+		settings_mount_fcb_backend(&cf);
+	}
+
+	return err;
+}
+
+static int save(const char *subtree, int key, uint32_t value)
+{
+	char name[24];
+
+	snprintf(name, sizeof(name), "bench/%s/k%04d", subtree, key);
+
+	return settings_save_one(name, &value, sizeof(value));
+}
+
+static int measure(int keys)
+{
+	uint32_t start, load_cycles, subtree_cycles;
+	uint32_t load_bytes, subtree_bytes;
+	int err;
+
+	err = mount();
+	if (err) {
+		printk("mount failed (%d)\n", err);
+		return err;
+	}
+
+	loaded = 0;
+	load_bytes = *bytes_read;
+	start = k_cycle_get_32();
+	err = settings_load();
+	load_cycles = k_cycle_get_32() - start;
+	load_bytes = *bytes_read - load_bytes;
+
+	if (err || loaded != keys + SMALL_KEYS) {
+		printk("load failed (%d), %d settings loaded\n", err, loaded);
+		return -1;
+	}
+
+	err = mount();
+	if (err) {
+		printk("mount failed (%d)\n", err);
+		return err;
+	}
+
+	loaded = 0;
+	subtree_bytes = *bytes_read;
+	start = k_cycle_get_32();
+	err = settings_load_subtree("bench/small");
+	subtree_cycles = k_cycle_get_32() - start;
+	subtree_bytes = *bytes_read - subtree_bytes;
+
+	if (err || loaded != SMALL_KEYS) {
+		printk("load failed (%d), %d settings loaded\n", err, loaded);
+		return -1;
+	}
+
+	printk("keys %4d load %9u cycles %7u bytes "
+	       "subtree %9u cycles %7u bytes\n", keys, load_cycles,
+	       load_bytes, subtree_cycles, subtree_bytes);
+
+	return 0;
+}
+
+void main(void)
+{
+	const struct flash_area *fa;
+	uint32_t value = 0U;
+	int err, n = 0;
+
+	stats_walk(stats_group_find("flash_sim_stats"), bytes_read_find, NULL);
+	if (!bytes_read) {
+		printk("no flash simulator statistics\n");
+		return;
+	}
+
+	err = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (err == 0) {
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+	if (err == 0) {
+		err = mount();
+	}
+	for (int i = 0; i < SMALL_KEYS && !err; i++) {
+		err = save("small", i, value);
+	}
+	if (err) {
+		printk("settings setup failed (%d)\n", err);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		while (n < sizes[i]) {
+			err = save("big", n, value);
+			if (err) {
+				printk("save of key %d failed (%d)\n", n, err);
+				return;
+			}
+			n++;
+		}
+
+		/* Leave an older value of every setting behind */
+		value++;
+		for (int key = 0; key < n && !err; key++) {
+			err = save("big", key, value);
+		}
+		if (err) {
+			printk("update failed (%d)\n", err);
+			return;
+		}
+
+		if (measure(n) < 0) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
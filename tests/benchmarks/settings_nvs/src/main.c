@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <storage/flash_map.h>
+#include <stats/stats.h>
+#include <settings/settings.h>
+
+/* Cost of saving and deleting a setting with the NVS back-end among a
+ * growing number of stored settings.  See README.rst.
+ */
+
+#define NUM_SAMPLES 10
+
+static const int sizes[] = { 10, 100, 250, 500, 1000 };
+
+static uint32_t *bytes_read;
+
+static int bytes_read_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	if (!strcmp(name, "bytes_read")) {
+		bytes_read = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static int save(int key, uint32_t value)
+{
+	char name[16];
+
+	snprintf(name, sizeof(name), "bench/k%04d", key);
+
+	return settings_save_one(name, &value, sizeof(value));
+}
+
+static int delete(int key)
+{
+	char name[16];
+
+	snprintf(name, sizeof(name), "bench/k%04d", key);
+
+	return settings_delete(name);
+}
+
+static int measure(int keys, uint32_t value)
+{
+	uint32_t start, save_cycles = 0U, delete_cycles = 0U;
+	uint32_t save_bytes, delete_bytes;
+	int key, err = 0;
+
+	save_bytes = *bytes_read;
+
+	for (int i = 0; i < NUM_SAMPLES && !err; i++) {
+		key = i * keys / NUM_SAMPLES;
+
+		start = k_cycle_get_32();
+		err = save(key, value);
+		save_cycles += k_cycle_get_32() - start;
+	}
+
+	save_bytes = *bytes_read - save_bytes;
+	delete_bytes = *bytes_read;
+
+	for (int i = 0; i < NUM_SAMPLES && !err; i++) {
+		key = i * keys / NUM_SAMPLES;
+
+		start = k_cycle_get_32();
+		err = delete(key);
+		delete_cycles += k_cycle_get_32() - start;
+	}
+
+	delete_bytes = *bytes_read - delete_bytes;
+
+	/* Store the deleted settings again for the next round */
+	for (int i = 0; i < NUM_SAMPLES && !err; i++) {
+		err = save(i * keys / NUM_SAMPLES, value);
+	}
+
+	if (err) {
+		printk("settings update failed (%d)\n", err);
+		return err;
+	}
+
+	printk("keys %4d save %8u cycles %7u bytes "
+	       "delete %8u cycles %7u bytes\n", keys,
+	       save_cycles / NUM_SAMPLES, save_bytes / NUM_SAMPLES,
+	       delete_cycles / NUM_SAMPLES, delete_bytes / NUM_SAMPLES);
+
+	return 0;
+}
+
+void main(void)
+{
+	const struct flash_area *fa;
+	uint32_t value = 0U;
+	int err, n = 0;
+
+	stats_walk(stats_group_find("flash_sim_stats"), bytes_read_find, NULL);
+	if (!bytes_read) {
+		printk("no flash simulator statistics\n");
+		return;
+	}
+
+	err = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (err == 0) {
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+	if (err == 0) {
+		err = settings_subsys_init();
+	}
+	if (err) {
+		printk("settings setup failed (%d)\n", err);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		while (n < sizes[i]) {
+			err = save(n, value);
+			if (err) {
+				printk("save of key %d failed (%d)\n", n, err);
+				return;
+			}
+			n++;
+		}
+
+		/* Every save changes the value, unchanged ones are skipped */
+		if (measure(sizes[i], ++value) < 0) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
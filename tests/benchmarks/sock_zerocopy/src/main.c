@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* Cost of receiving a UDP datagram of growing size with recv(), which
+ * copies it, and with zsock_recv_zerocopy().  See README.rst.
+ */
+
+#define SERVER_PORT 4242
+#define NUM_RUNS 1000
+#define MAX_SIZE 1400
+#define MAX_VIEWS 16
+
+static const size_t sizes[] = { 64, 256, 512, 1024, MAX_SIZE };
+
+static uint8_t tx_buf[MAX_SIZE];
+static uint8_t rx_buf[MAX_SIZE];
+
+static struct iovec views[MAX_VIEWS];
+
+static bool verify(int c_sock, int s_sock, size_t size)
+{
+	struct zsock_zerocopy zc = {
+		.iov = views,
+		.iovlen = MAX_VIEWS,
+	};
+	size_t len = 0;
+	bool ok = true;
+
+	if (send(c_sock, tx_buf, size, 0) != size ||
+	    zsock_recv_zerocopy(s_sock, &zc, 0) != size) {
+		printk("transfer failed (%d)\n", errno);
+		return false;
+	}
+
+	for (size_t i = 0; i < zc.iovlen && ok; i++) {
+		ok = !memcmp(views[i].iov_base, tx_buf + len,
+			     views[i].iov_len);
+		len += views[i].iov_len;
+	}
+
+	zsock_recv_zerocopy_release(&zc);
+
+	if (!ok || len != size) {
+		printk("data mismatch, size %zu\n", size);
+		return false;
+	}
+
+	return true;
+}
+
+static int measure(int c_sock, int s_sock, size_t size)
+{
+	uint32_t start, copy_cycles = 0, zc_cycles = 0;
+	struct zsock_zerocopy zc = {
+		.iov = views,
+	};
+	ssize_t ret;
+
+	for (int i = 0; i < NUM_RUNS; i++) {
+		if (send(c_sock, tx_buf, size, 0) != size) {
+			return -1;
+		}
+
+		start = k_cycle_get_32();
+		ret = recv(s_sock, rx_buf, sizeof(rx_buf), 0);
+		copy_cycles += k_cycle_get_32() - start;
+
+		if (ret != size) {
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < NUM_RUNS; i++) {
+		if (send(c_sock, tx_buf, size, 0) != size) {
+			return -1;
+		}
+
+		zc.iovlen = MAX_VIEWS;
+
+		start = k_cycle_get_32();
+		ret = zsock_recv_zerocopy(s_sock, &zc, 0);
+		zsock_recv_zerocopy_release(&zc);
+		zc_cycles += k_cycle_get_32() - start;
+
+		if (ret != size) {
+			return -1;
+		}
+	}
+
+	printk("size %4zu %6u cycles copy %6u cycles zerocopy\n", size,
+	       copy_cycles / NUM_RUNS, zc_cycles / NUM_RUNS);
+
+	return 0;
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int s_sock, c_sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	for (size_t i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	c_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (s_sock < 0 || c_sock < 0 ||
+	    bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("socket setup failed (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		if (!verify(c_sock, s_sock, sizes[i])) {
+			return;
+		}
+
+		if (measure(c_sock, s_sock, sizes[i]) < 0) {
+			printk("transfer failed, size %zu (%d)\n", sizes[i],
+			       errno);
+			return;
+		}
+	}
+
+	close(c_sock);
+	close(s_sock);
+
+	printk("fin\n");
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/ethernet.h>
+
+#include "ipv6.h"
+
+/* CPU cost of a bulk TCP transfer over an Ethernet interface, with and
+ * without TCP segmentation offload.  See README.rst.
+ */
+
+#define SERVER_PORT 4242
+#define XFER_SIZE (1024 * 1024)
+#define CHUNK_SIZE 4096
+#define STACK_SIZE 2048
+
+#define MY_IPV6_ADDR "2001:db8::1"
+#define PEER_IPV6_ADDR "2001:db8::2"
+
+static uint8_t tx_buf[CHUNK_SIZE];
+static uint8_t rx_buf[CHUNK_SIZE];
+
+K_THREAD_STACK_DEFINE(rx_stack, STACK_SIZE);
+static struct k_thread rx_thread;
+
+static size_t rx_total;
+
+/* The driver loops the frames back, as if they came from the peer */
+struct eth_loop_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+	bool offload;
+	uint32_t frames;
+};
+
+static struct eth_loop_context eth_loop_data = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+};
+
+static void eth_loop_iface_init(struct net_if *iface)
+{
+	struct eth_loop_context *ctx = net_if_get_device(iface)->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+/* The checksums are left out in all modes, the segments of the
+ * offload mode are aggregated again on the way back.
+ */
+static enum ethernet_hw_caps eth_loop_caps(const struct device *dev)
+{
+	struct eth_loop_context *ctx = dev->data;
+
+	return ETHERNET_HW_TX_CHKSUM_OFFLOAD | ETHERNET_HW_RX_CHKSUM_OFFLOAD |
+	       (ctx->offload ? ETHERNET_HW_TSO | ETHERNET_HW_LRO : 0);
+}
+
+static int eth_loop_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_loop_context *ctx = dev->data;
+	size_t len = net_pkt_get_len(pkt);
+	struct net_ipv6_hdr *hdr;
+	struct in6_addr addr;
+	struct net_pkt *rx;
+
+	rx = net_pkt_rx_alloc_with_buffer(ctx->iface, len, AF_UNSPEC, 0,
+					  K_NO_WAIT);
+	if (!rx) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_copy(rx, pkt, len)) {
+		net_pkt_unref(rx);
+		return -ENOBUFS;
+	}
+
+	/* Swapping the addresses leaves the checksums unchanged */
+	hdr = (struct net_ipv6_hdr *)(rx->buffer->data +
+				      sizeof(struct net_eth_hdr));
+	net_ipaddr_copy(&addr, &hdr->src);
+	net_ipaddr_copy(&hdr->src, &hdr->dst);
+	net_ipaddr_copy(&hdr->dst, &addr);
+
+	ctx->frames++;
+
+	if (net_recv_data(ctx->iface, rx) < 0) {
+		net_pkt_unref(rx);
+	}
+
+	return 0;
+}
+
+static int eth_loop_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct ethernet_api eth_loop_api = {
+	.iface_api.init = eth_loop_iface_init,
+	.get_capabilities = eth_loop_caps,
+	.send = eth_loop_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_loop, "eth_loop", eth_loop_init,
+		    device_pm_control_nop, &eth_loop_data, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_loop_api, NET_ETH_MTU);
+
+static void rx_fn(void *p1, void *p2, void *p3)
+{
+	int s_sock = POINTER_TO_INT(p1);
+	ssize_t len;
+	int sock;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = accept(s_sock, NULL, NULL);
+	if (sock < 0) {
+		printk("accept failed (%d)\n", errno);
+		return;
+	}
+
+	while (rx_total < XFER_SIZE) {
+		len = recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (len <= 0) {
+			printk("recv failed (%d)\n", errno);
+			break;
+		}
+		rx_total += len;
+	}
+
+	close(sock);
+}
+
+static int transfer(const char *mode)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(SERVER_PORT),
+	};
+	int s_sock, c_sock;
+	uint32_t start, cycles;
+	int ret = -1;
+
+	s_sock = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	if (s_sock < 0 ||
+	    bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(s_sock, 1) < 0) {
+		printk("server setup failed (%d)\n", errno);
+		return -1;
+	}
+
+	rx_total = 0;
+	k_thread_create(&rx_thread, rx_stack, STACK_SIZE, rx_fn,
+			INT_TO_POINTER(s_sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	/* The peer address leads through the driver back to the server */
+	inet_pton(AF_INET6, PEER_IPV6_ADDR, &addr.sin6_addr);
+
+	c_sock = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	if (c_sock < 0 ||
+	    connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed (%d)\n", errno);
+		goto out;
+	}
+
+	eth_loop_data.frames = 0U;
+	start = k_cycle_get_32();
+
+	for (size_t pos = 0; pos < XFER_SIZE; pos += CHUNK_SIZE) {
+		if (send(c_sock, tx_buf, CHUNK_SIZE, 0) != CHUNK_SIZE) {
+			printk("send failed (%d)\n", errno);
+			goto out;
+		}
+	}
+
+	if (k_thread_join(&rx_thread, K_SECONDS(120)) < 0) {
+		printk("transfer did not complete, got %zu bytes\n", rx_total);
+		goto out;
+	}
+
+	/* Data segments and the ACKs in the other direction */
+	cycles = k_cycle_get_32() - start;
+	printk("%-8s %10u cycles/MB %6u frames\n", mode,
+	       (uint32_t)((uint64_t)cycles * 1024 * 1024 / XFER_SIZE),
+	       eth_loop_data.frames);
+	ret = 0;
+out:
+	close(c_sock);
+	close(s_sock);
+
+	/* Let the connection go away before the next one */
+	k_sleep(K_SECONDS(1));
+
+	return ret;
+}
+
+void main(void)
+{
+	struct net_if *iface = eth_loop_data.iface;
+	struct in6_addr addr;
+	struct net_linkaddr lladdr = {
+		.addr = eth_loop_data.mac_addr,
+		.len = sizeof(eth_loop_data.mac_addr),
+		.type = NET_LINK_ETHERNET,
+	};
+
+	inet_pton(AF_INET6, MY_IPV6_ADDR, &addr);
+	if (!net_if_ipv6_addr_add(iface, &addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add address\n");
+		return;
+	}
+
+	/* The frames to the peer are addressed to ourselves */
+	inet_pton(AF_INET6, PEER_IPV6_ADDR, &addr);
+	if (!net_ipv6_nbr_add(iface, &addr, &lladdr, false,
+			      NET_IPV6_NBR_STATE_STATIC)) {
+		printk("cannot add neighbor\n");
+		return;
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO)) {
+		if (transfer("segments") < 0) {
+			return;
+		}
+	} else {
+		if (transfer("software") < 0) {
+			return;
+		}
+
+		eth_loop_data.offload = true;
+		if (transfer("offload") < 0) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
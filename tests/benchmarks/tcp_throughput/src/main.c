@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/loopback.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+
+/* Goodput of a bulk TCP transfer over a loopback interface with a fixed
+ * delay, for a growing receive buffer.  See README.rst.
+ */
+
+#define SERVER_PORT 4242
+#define XFER_SIZE (512 * 1024)
+#define CHUNK_SIZE 1024
+#define DELAY_MS 10
+#define STACK_SIZE 2048
+
+static const int rcvbufs[] = { 1280, 16384, 65535, 262144 };
+
+static uint8_t tx_buf[CHUNK_SIZE];
+static uint8_t rx_buf[CHUNK_SIZE];
+
+K_THREAD_STACK_DEFINE(rx_stack, STACK_SIZE);
+static struct k_thread rx_thread;
+
+static size_t rx_total;
+static uint32_t rx_end;
+
+static void rx_fn(void *p1, void *p2, void *p3)
+{
+	int s_sock = POINTER_TO_INT(p1);
+	ssize_t len;
+	int sock;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = accept(s_sock, NULL, NULL);
+	if (sock < 0) {
+		printk("accept failed (%d)\n", errno);
+		return;
+	}
+
+	while (rx_total < XFER_SIZE) {
+		len = recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (len <= 0) {
+			printk("recv failed (%d)\n", errno);
+			break;
+		}
+		rx_total += len;
+	}
+	rx_end = k_uptime_get_32();
+
+	close(sock);
+}
+
+static uint32_t packets_sent(void)
+{
+	struct net_stats_ip ipv4;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_IPV4, NULL, &ipv4,
+		     sizeof(ipv4)) < 0) {
+		return 0;
+	}
+
+	return ipv4.sent;
+}
+
+static int transfer(int rcvbuf)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint32_t start, packets, ms;
+	int s_sock, c_sock;
+	int ret = -1;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	/* Accepted sockets get the buffer size of the listening one */
+	s_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (s_sock < 0 ||
+	    setsockopt(s_sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf,
+		       sizeof(rcvbuf)) < 0 ||
+	    bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(s_sock, 1) < 0) {
+		printk("server setup failed (%d)\n", errno);
+		return -1;
+	}
+
+	rx_total = 0;
+	k_thread_create(&rx_thread, rx_stack, STACK_SIZE, rx_fn,
+			INT_TO_POINTER(s_sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	c_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (c_sock < 0 ||
+	    connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed (%d)\n", errno);
+		goto out;
+	}
+
+	packets = packets_sent();
+	start = k_uptime_get_32();
+
+	for (size_t pos = 0; pos < XFER_SIZE; pos += CHUNK_SIZE) {
+		if (send(c_sock, tx_buf, CHUNK_SIZE, 0) != CHUNK_SIZE) {
+			printk("send failed (%d)\n", errno);
+			goto out;
+		}
+	}
+
+	if (k_thread_join(&rx_thread, K_SECONDS(120)) < 0) {
+		printk("transfer did not complete, got %zu bytes\n", rx_total);
+		goto out;
+	}
+
+	/* Data segments and the ACKs in the other direction */
+	packets = packets_sent() - packets;
+	ms = MAX(rx_end - start, 1U);
+	printk("rcvbuf %6d %8u bytes/s %6u packets\n", rcvbuf,
+	       (uint32_t)((uint64_t)XFER_SIZE * MSEC_PER_SEC / ms), packets);
+	ret = 0;
+out:
+	close(c_sock);
+	close(s_sock);
+
+	/* Let the connection go away before the next one */
+	k_sleep(K_SECONDS(1));
+
+	return ret;
+}
+
+void main(void)
+{
+	printk("delay %u ms, window scaling %s, ACK delay %u ms\n", DELAY_MS,
+	       IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? "on" : "off",
+	       CONFIG_NET_TCP_ACK_DELAY);
+
+	loopback_set_packet_delay(DELAY_MS);
+
+	for (int i = 0; i < ARRAY_SIZE(rcvbufs); i++) {
+		if (transfer(rcvbufs[i]) < 0) {
+			return;
+		}
+	}
+	printk("fin\n");
+}
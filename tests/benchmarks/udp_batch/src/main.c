@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* Cost of sending and receiving small UDP datagrams with sendmmsg() and
+ * recvmmsg(), for a growing number of datagrams per call.  See README.rst.
+ */
+
+#define SERVER_PORT 4242
+#define NUM_PKTS 4096
+#define PKT_SIZE 64
+#define MAX_BATCH 32
+
+static const unsigned int batches[] = { 1, 2, 4, 8, 16, MAX_BATCH };
+
+static uint8_t tx_buf[PKT_SIZE];
+static uint8_t rx_buf[MAX_BATCH][PKT_SIZE];
+
+static struct mmsghdr tx_msgs[MAX_BATCH];
+static struct mmsghdr rx_msgs[MAX_BATCH];
+static struct iovec tx_iov;
+static struct iovec rx_iov[MAX_BATCH];
+
+static int measure(int c_sock, int s_sock, unsigned int batch)
+{
+	uint64_t cycles = 0;
+	uint32_t start;
+	int ret;
+
+	for (unsigned int i = 0; i < batch; i++) {
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov;
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	for (unsigned int n = 0; n < NUM_PKTS; n += batch) {
+		start = k_cycle_get_32();
+
+		ret = sendmmsg(c_sock, tx_msgs, batch, 0);
+		if (ret != batch) {
+			printk("sendmmsg failed (%d, %d)\n", ret, errno);
+			return -1;
+		}
+
+		ret = recvmmsg(s_sock, rx_msgs, batch, 0);
+		if (ret != batch) {
+			printk("recvmmsg failed (%d, %d)\n", ret, errno);
+			return -1;
+		}
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	cycles /= NUM_PKTS;
+	printk("batch %2u %6u cycles/packet %8u packets/s\n", batch,
+	       (uint32_t)cycles,
+	       (uint32_t)(sys_clock_hw_cycles_per_sec() / MAX(cycles, 1)));
+
+	return 0;
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int s_sock, c_sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	tx_iov.iov_base = tx_buf;
+	tx_iov.iov_len = sizeof(tx_buf);
+
+	for (int i = 0; i < MAX_BATCH; i++) {
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = sizeof(rx_buf[i]);
+	}
+
+	s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	c_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (s_sock < 0 || c_sock < 0 ||
+	    bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("socket setup failed (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(batches); i++) {
+		if (measure(c_sock, s_sock, batches[i]) < 0) {
+			return;
+		}
+	}
+
+	close(c_sock);
+	close(s_sock);
+
+	printk("fin\n");
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * @brief Test event objects
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_WAITERS	3
+#define TIMEOUT		K_MSEC(100)
+
+#define EV_A	BIT(0)
+#define EV_B	BIT(1)
+#define EV_C	BIT(2)
+
+static K_EVENT_DEFINE(event);
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, NUM_WAITERS, STACK_SIZE);
+static struct k_thread tdata[NUM_WAITERS];
+static volatile uint32_t results[NUM_WAITERS];
+
+struct wait_spec {
+	uint32_t events;
+	bool all;
+	bool clear;
+};
+
+static void tIsr_entry_set(const void *p)
+{
+	k_event_set(&event, POINTER_TO_UINT(p));
+}
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	const struct wait_spec *spec = p1;
+	uint32_t id = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	if (spec->all) {
+		results[id] = k_event_wait_all(&event, spec->events,
+					       spec->clear, TIMEOUT);
+	} else {
+		results[id] = k_event_wait(&event, spec->events, spec->clear,
+					   TIMEOUT);
+	}
+}
+
+static void start_waiters(const struct wait_spec *specs, int num)
+{
+	for (int i = 0; i < num; i++) {
+		results[i] = UINT32_MAX;
+		k_thread_create(&tdata[i], tstack[i], STACK_SIZE, waiter_fn,
+				(void *)&specs[i], UINT_TO_POINTER(i), NULL,
+				K_PRIO_PREEMPT(i), 0, K_NO_WAIT);
+	}
+
+	/* Let all of them block */
+	k_msleep(10);
+}
+
+static void join_waiters(int num)
+{
+	for (int i = 0; i < num; i++) {
+		k_thread_join(&tdata[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test setting, clearing and waiting without blocking
+ *
+ * @see k_event_set(), k_event_clear(), k_event_wait(), k_event_wait_all()
+ */
+static void test_event_no_wait(void)
+{
+	k_event_init(&event);
+	zassert_equal(k_event_get(&event), 0, NULL);
+	zassert_equal(k_event_wait(&event, EV_A, false, K_NO_WAIT), 0, NULL);
+
+	k_event_set(&event, EV_A | EV_C);
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, false, K_NO_WAIT),
+		      EV_A, NULL);
+	zassert_equal(k_event_wait_all(&event, EV_A | EV_B, false, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal(k_event_wait_all(&event, EV_A | EV_C, false, K_NO_WAIT),
+		      EV_A | EV_C, NULL);
+
+	/* Only the returned events are consumed */
+	zassert_equal(k_event_wait(&event, EV_C, true, K_NO_WAIT), EV_C,
+		      NULL);
+	zassert_equal(k_event_get(&event), EV_A, NULL);
+
+	k_event_clear(&event, EV_A | EV_B);
+	zassert_equal(k_event_get(&event), 0, NULL);
+	zassert_equal(k_event_wait(&event, EV_A, false, K_MSEC(10)), 0, NULL);
+
+	irq_offload(tIsr_entry_set, UINT_TO_POINTER(EV_B));
+	zassert_equal(k_event_wait(&event, EV_B, true, K_NO_WAIT), EV_B, NULL);
+}
+
+/**
+ * @brief Test which waiters a single set wakes up
+ *
+ * @details Waiters whose condition holds all wake up, the others keep
+ * waiting, and a consuming waiter takes its events away from lower
+ * priority waiters.
+ *
+ * @see k_event_set(), k_event_wait(), k_event_wait_all()
+ */
+static void test_event_waiters(void)
+{
+	static const struct wait_spec specs[] = {
+		{ .events = EV_A, .clear = true },
+		{ .events = EV_A | EV_B },
+		{ .events = EV_A | EV_B, .all = true },
+	};
+
+	k_event_init(&event);
+	start_waiters(specs, ARRAY_SIZE(specs));
+
+	/* Waiter 0 consumes A, so waiter 1 only sees B and waiter 2
+	 * keeps waiting
+	 */
+	k_event_set(&event, EV_A | EV_B);
+	k_msleep(10);
+	zassert_equal(results[0], EV_A, NULL);
+	zassert_equal(results[1], EV_B, NULL);
+	zassert_equal(results[2], UINT32_MAX, NULL);
+
+	irq_offload(tIsr_entry_set, UINT_TO_POINTER(EV_A));
+	join_waiters(ARRAY_SIZE(specs));
+	zassert_equal(results[2], EV_A | EV_B, NULL);
+	zassert_equal(k_event_get(&event), EV_A | EV_B, NULL);
+
+	/* Timeouts */
+	k_event_init(&event);
+	start_waiters(specs, 1);
+	join_waiters(1);
+	zassert_equal(results[0], 0, NULL);
+}
+
+/**
+ * @brief Test polling an event object
+ *
+ * @see k_poll(), k_event_set()
+ */
+static void test_event_poll(void)
+{
+	struct k_poll_event poll_event;
+
+	k_event_init(&event);
+	k_poll_event_init(&poll_event, K_POLL_TYPE_EVENTS,
+			  K_POLL_MODE_NOTIFY_ONLY, &event);
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	k_event_set(&event, 0);
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	irq_offload(tIsr_entry_set, UINT_TO_POINTER(EV_C));
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(poll_event.state, K_POLL_STATE_EVENTS, NULL);
+	zassert_equal(k_event_wait(&event, EV_C, true, K_NO_WAIT), EV_C,
+		      NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_event_api,
+			 ztest_unit_test(test_event_no_wait),
+			 ztest_1cpu_unit_test(test_event_waiters),
+			 ztest_unit_test(test_event_poll));
+	ztest_run_test_suite(test_event_api);
+}
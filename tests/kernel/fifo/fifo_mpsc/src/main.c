@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * @brief Test the lock-free MPSC queue and the FIFO built on it
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/mpsc_lockfree.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define LIST_LEN	4
+#define NUM_PRODUCERS	3
+#define PRODUCER_ITEMS	100
+
+struct fdata_t {
+	struct mpsc_node node;
+	uint32_t producer;
+	uint32_t seq;
+};
+
+static struct mpsc queue = MPSC_INIT(queue);
+static K_FIFO_MPSC_DEFINE(fifo);
+
+static struct fdata_t data[LIST_LEN];
+static struct fdata_t data_isr[LIST_LEN];
+static struct fdata_t data_prod[NUM_PRODUCERS][PRODUCER_ITEMS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread tdata[NUM_PRODUCERS];
+
+static void tIsr_entry_put(const void *p)
+{
+	for (uint32_t i = 0U; i < LIST_LEN; i++) {
+		k_fifo_mpsc_put((struct k_fifo_mpsc *)p, &data_isr[i]);
+	}
+}
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0U; i < PRODUCER_ITEMS; i++) {
+		data_prod[id][i].producer = id;
+		data_prod[id][i].seq = i;
+		k_fifo_mpsc_put(&fifo, &data_prod[id][i]);
+		if ((i % 8) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test MPSC queue push and pop order, including the stub node
+ * being cycled through the queue
+ *
+ * @see mpsc_push(), mpsc_pop(), mpsc_is_empty()
+ */
+static void test_mpsc_queue(void)
+{
+	zassert_true(mpsc_is_empty(&queue), NULL);
+	zassert_is_null(mpsc_pop(&queue), NULL);
+
+	for (int round = 0; round < 3; round++) {
+		for (uint32_t i = 0U; i < LIST_LEN; i++) {
+			mpsc_push(&queue, &data[i].node);
+		}
+		zassert_false(mpsc_is_empty(&queue), NULL);
+
+		for (uint32_t i = 0U; i < LIST_LEN; i++) {
+			zassert_equal(mpsc_pop(&queue), &data[i].node, NULL);
+		}
+		zassert_true(mpsc_is_empty(&queue), NULL);
+		zassert_is_null(mpsc_pop(&queue), NULL);
+	}
+
+	/* Interleave pushes and pops */
+	mpsc_push(&queue, &data[0].node);
+	zassert_equal(mpsc_pop(&queue), &data[0].node, NULL);
+	mpsc_push(&queue, &data[1].node);
+	mpsc_push(&queue, &data[2].node);
+	zassert_equal(mpsc_pop(&queue), &data[1].node, NULL);
+	mpsc_push(&queue, &data[0].node);
+	zassert_equal(mpsc_pop(&queue), &data[2].node, NULL);
+	zassert_equal(mpsc_pop(&queue), &data[0].node, NULL);
+	zassert_is_null(mpsc_pop(&queue), NULL);
+}
+
+/**
+ * @brief Test lock-free FIFO put and get from thread and ISR context
+ *
+ * @see k_fifo_mpsc_put(), k_fifo_mpsc_get(), k_fifo_mpsc_is_empty()
+ */
+static void test_fifo_mpsc_isr(void)
+{
+	zassert_true(k_fifo_mpsc_is_empty(&fifo), NULL);
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_NO_WAIT), NULL);
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_MSEC(10)), NULL);
+
+	irq_offload(tIsr_entry_put, &fifo);
+	zassert_false(k_fifo_mpsc_is_empty(&fifo), NULL);
+
+	for (uint32_t i = 0U; i < LIST_LEN; i++) {
+		zassert_equal(k_fifo_mpsc_get(&fifo, K_NO_WAIT),
+			      &data_isr[i], NULL);
+	}
+	zassert_true(k_fifo_mpsc_is_empty(&fifo), NULL);
+}
+
+/**
+ * @brief Test a consumer pending on a lock-free FIFO fed by several
+ * producer threads
+ *
+ * @details Every item must arrive exactly once and in order with
+ * respect to the other items of the same producer.
+ *
+ * @see k_fifo_mpsc_put(), k_fifo_mpsc_get()
+ */
+static void test_fifo_mpsc_producers(void)
+{
+	uint32_t next[NUM_PRODUCERS] = { 0 };
+
+	for (uint32_t i = 0U; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&tdata[i], tstack[i], STACK_SIZE,
+				producer_fn, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_MSEC(1));
+	}
+
+	for (uint32_t n = 0U; n < NUM_PRODUCERS * PRODUCER_ITEMS; n++) {
+		struct fdata_t *item = k_fifo_mpsc_get(&fifo, K_FOREVER);
+
+		zassert_not_null(item, NULL);
+		zassert_true(item->producer < NUM_PRODUCERS, NULL);
+		zassert_equal(item->seq, next[item->producer], NULL);
+		next[item->producer]++;
+	}
+
+	for (uint32_t i = 0U; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&tdata[i], K_FOREVER);
+	}
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_NO_WAIT), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_fifo_mpsc,
+			 ztest_unit_test(test_mpsc_queue),
+			 ztest_unit_test(test_fifo_mpsc_isr),
+			 ztest_unit_test(test_fifo_mpsc_producers));
+	ztest_run_test_suite(test_fifo_mpsc);
+}
@@ -23,6 +23,11 @@ extern void test_msgq_alloc(void);
 extern void test_msgq_pend_thread(void);
 extern void test_msgq_empty(void);
 extern void test_msgq_full(void);
+extern void test_msgq_claim(void);
+extern void test_msgq_claim_pend(void);
+extern void test_msgq_claim_purge(void);
+extern void test_msgq_many(void);
+extern void test_msgq_many_pend(void);
 #ifdef CONFIG_USERSPACE
 extern void test_msgq_user_thread(void);
 extern void test_msgq_user_thread_overflow(void);
@@ -83,6 +88,11 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_msgq_pend_thread),
 			 ztest_1cpu_unit_test(test_msgq_empty),
 			 ztest_1cpu_unit_test(test_msgq_full),
+			 ztest_unit_test(test_msgq_claim),
+			 ztest_1cpu_unit_test(test_msgq_claim_pend),
+			 ztest_1cpu_unit_test(test_msgq_claim_purge),
+			 ztest_unit_test(test_msgq_many),
+			 ztest_1cpu_unit_test(test_msgq_many_pend),
 			 ztest_unit_test(test_msgq_alloc));
 	ztest_run_test_suite(msgq_api);
 }
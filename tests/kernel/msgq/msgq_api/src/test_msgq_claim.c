@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+K_MSGQ_DEFINE(cmsgq, MSG_SIZE, MSGQ_LEN, 4);
+static uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+
+static void put_claimed(struct k_msgq *q, uint32_t msg)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_put_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	*(uint32_t *)slot = msg;
+	k_msgq_put_commit(q);
+}
+
+static uint32_t get_claimed(struct k_msgq *q)
+{
+	void *slot;
+	uint32_t msg;
+
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	msg = *(uint32_t *)slot;
+	k_msgq_get_release(q);
+	return msg;
+}
+
+static void get_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = 0;
+
+	zassert_equal(k_msgq_get(p1, &msg, TIMEOUT), 0, NULL);
+	zassert_equal(msg, MSG0, NULL);
+}
+
+static K_SEM_DEFINE(claimed_sem, 0, 1);
+static K_SEM_DEFINE(release_sem, 0, 1);
+
+static void get_claim_thread_entry(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_get_claim(p1, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, MSG1, NULL);
+	k_sem_give(&claimed_sem);
+	k_sem_take(&release_sem, K_FOREVER);
+	k_msgq_get_release(p1);
+}
+
+static void put_claim_thread_entry(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_put_claim(p1, &slot, TIMEOUT), 0, NULL);
+	*(uint32_t *)slot = MSG1;
+	k_msgq_put_commit(p1);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test zero-copy sending and receiving through claimed slots
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_claim(void)
+{
+	void *slot, *slot2;
+	uint32_t msg;
+
+	k_msgq_purge(&cmsgq);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/* A claimed slot holds back other senders until committed */
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot2, K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_put(&cmsgq, &data[1], K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+	*(uint32_t *)slot = MSG0;
+	k_msgq_put_commit(&cmsgq);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 1, NULL);
+
+	/* Mixes with the copying API in FIFO order */
+	zassert_equal(k_msgq_put(&cmsgq, &data[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), -ENOMSG,
+		      NULL);
+
+	/* A claimed message holds back other receivers until released */
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, MSG0, NULL);
+	zassert_equal(k_msgq_get(&cmsgq, &msg, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot2, K_NO_WAIT), -EBUSY,
+		      NULL);
+	k_msgq_get_release(&cmsgq);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 1, NULL);
+	zassert_equal(get_claimed(&cmsgq), MSG1, NULL);
+
+	/* Wrap around the ring a few times */
+	for (int i = 0; i < 3 * MSGQ_LEN; i++) {
+		put_claimed(&cmsgq, data[i % MSGQ_LEN]);
+		zassert_equal(get_claimed(&cmsgq), data[i % MSGQ_LEN], NULL);
+	}
+
+	/* Purging drops a claimed message, its release is a no-op */
+	put_claimed(&cmsgq, MSG0);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	k_msgq_purge(&cmsgq);
+	k_msgq_get_release(&cmsgq);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+}
+
+/**
+ * @brief Test claims against threads blocked on the message queue
+ * @details A receiver blocked on an empty queue gets a committed
+ * message, and a sender blocked claiming a slot of a full queue gets
+ * one once a claimed message is released.
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_claim_pend(void)
+{
+	void *slot;
+
+	k_msgq_purge(&cmsgq);
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      get_thread_entry, &cmsgq, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	k_msleep(TIMEOUT_MS >> 1);
+	put_claimed(&cmsgq, MSG0);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+
+	/* Fill the queue, then have a thread wait to claim a slot */
+	put_claimed(&cmsgq, MSG0);
+	zassert_equal(k_msgq_put(&cmsgq, &data[0], K_NO_WAIT), 0, NULL);
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      put_claim_thread_entry, &cmsgq, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	k_msgq_get_release(&cmsgq);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(get_claimed(&cmsgq), MSG0, NULL);
+	zassert_equal(get_claimed(&cmsgq), MSG1, NULL);
+}
+
+/**
+ * @brief Test a release of a claim ended by a purge
+ * @details Another thread claims a message after the purge.  The release
+ * of the purged claim must leave that claim and the ring alone.
+ * @see k_msgq_get_claim(), k_msgq_get_release(), k_msgq_purge()
+ */
+void test_msgq_claim_purge(void)
+{
+	void *slot;
+
+	k_msgq_purge(&cmsgq);
+	put_claimed(&cmsgq, MSG0);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	k_msgq_purge(&cmsgq);
+
+	put_claimed(&cmsgq, MSG1);
+	put_claimed(&cmsgq, MSG0);
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      get_claim_thread_entry, &cmsgq, NULL,
+				      NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&claimed_sem, TIMEOUT), 0, NULL);
+
+	/* The stale release leaves the other thread's claim alone */
+	k_msgq_get_release(&cmsgq);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 2, NULL);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), -EBUSY,
+		      NULL);
+
+	k_sem_give(&release_sem);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 1, NULL);
+	zassert_equal(get_claimed(&cmsgq), MSG0, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+K_MSGQ_DEFINE(mmsgq, MSG_SIZE, MANY_LEN, 4);
+static uint32_t src[2 * MANY_LEN] = {
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17
+};
+
+static void get_many_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msgs[MANY_LEN] = { 0 };
+
+	/* Returns as soon as the first message is handed over */
+	zassert_equal(k_msgq_get_many(p1, msgs, MANY_LEN, TIMEOUT), 1, NULL);
+	zassert_equal(msgs[0], src[0], NULL);
+}
+
+static void put_many_thread_entry(void *p1, void *p2, void *p3)
+{
+	/* Returns as soon as the first message is taken */
+	zassert_equal(k_msgq_put_many(p1, &src[5], 2, TIMEOUT), 1,
+		      NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages per call
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_many(void)
+{
+	uint32_t msgs[2 * MANY_LEN];
+	void *slot;
+
+	k_msgq_purge(&mmsgq);
+	zassert_equal(k_msgq_put_many(&mmsgq, src, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_many(&mmsgq, msgs, MANY_LEN, K_NO_WAIT),
+		      -ENOMSG, NULL);
+
+	/* Only as many messages as fit are sent */
+	zassert_equal(k_msgq_put_many(&mmsgq, src, 6, K_NO_WAIT), MANY_LEN,
+		      NULL);
+	zassert_equal(k_msgq_put_many(&mmsgq, src, 1, K_NO_WAIT), -ENOMSG,
+		      NULL);
+	zassert_equal(k_msgq_get_many(&mmsgq, msgs, 3, K_NO_WAIT), 3, NULL);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(msgs[i], src[i], NULL);
+	}
+
+	/* Sending and receiving across the end of the ring buffer */
+	zassert_equal(k_msgq_put_many(&mmsgq, &src[4], 4, K_NO_WAIT), 3,
+		      NULL);
+	zassert_equal(k_msgq_num_used_get(&mmsgq), MANY_LEN, NULL);
+	zassert_equal(k_msgq_get_many(&mmsgq, msgs, ARRAY_SIZE(msgs),
+				      K_NO_WAIT), MANY_LEN, NULL);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(msgs[i], src[i + 3], NULL);
+	}
+	zassert_equal(k_msgq_num_used_get(&mmsgq), 0, NULL);
+
+	/* Claims hold back batches like single messages */
+	zassert_equal(k_msgq_put_claim(&mmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_many(&mmsgq, src, 2, K_NO_WAIT), -EBUSY,
+		      NULL);
+	*(uint32_t *)slot = src[0];
+	k_msgq_put_commit(&mmsgq);
+	zassert_equal(k_msgq_get_claim(&mmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_many(&mmsgq, msgs, 2, K_NO_WAIT), -EBUSY,
+		      NULL);
+	k_msgq_get_release(&mmsgq);
+	zassert_equal(k_msgq_num_used_get(&mmsgq), 0, NULL);
+}
+
+/**
+ * @brief Test batches against threads blocked on the message queue
+ * @details A receiver blocked on an empty queue is handed the first
+ * message of a batch and the rest are queued, and a sender blocked on
+ * a full queue has its message taken straight into a batch receive.
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_many_pend(void)
+{
+	uint32_t msgs[2 * MANY_LEN];
+
+	k_msgq_purge(&mmsgq);
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      get_many_thread_entry, &mmsgq, NULL,
+				      NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_put_many(&mmsgq, src, 3, K_NO_WAIT), 3, NULL);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&mmsgq), 2, NULL);
+
+	/* Fill the queue, then have a thread wait to send */
+	zassert_equal(k_msgq_put_many(&mmsgq, &src[3], 2, K_NO_WAIT), 2,
+		      NULL);
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      put_many_thread_entry, &mmsgq, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_get_many(&mmsgq, msgs, ARRAY_SIZE(msgs),
+				      K_NO_WAIT), MANY_LEN + 1, NULL);
+	for (int i = 0; i <= MANY_LEN; i++) {
+		zassert_equal(msgs[i], src[i + 1], NULL);
+	}
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&mmsgq), 0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for vectored pipe reads and writes
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define PIPE_LEN 16
+#define TIMEOUT K_MSEC(100)
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_PIPE_DEFINE(vpipe, PIPE_LEN, 4);
+K_THREAD_STACK_DEFINE(vstack, STACK_SIZE);
+static struct k_thread vdata;
+
+static unsigned char seg_a[] = "abcd";
+static unsigned char seg_b[] = "efgh";
+static unsigned char seg_c[] = "ijkl";
+static unsigned char seg_d[] = "mnopqrst";
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	unsigned char buf[6];
+	size_t bytes;
+
+	zassert_equal(k_pipe_get(&vpipe, buf, sizeof(buf), &bytes, sizeof(buf),
+				 TIMEOUT), 0, NULL);
+	zassert_mem_equal(buf, "abcdef", sizeof(buf), NULL);
+}
+
+/**
+ * @brief Test writing and reading whole segments
+ * @see k_pipe_put_vec(), k_pipe_get_vec()
+ */
+void test_pipe_vec(void)
+{
+	unsigned char out1[4], out2[8];
+	struct k_pipe_vec in[] = {
+		{ seg_a, 4 }, { seg_b, 4 }, { seg_c, 4 }, { seg_d, 8 },
+	};
+	struct k_pipe_vec out[] = {
+		{ out1, sizeof(out1) }, { out2, sizeof(out2) },
+	};
+	size_t bytes;
+
+	/* Segments are written whole, up to the first that does not fit */
+	zassert_equal(k_pipe_put_vec(&vpipe, in, ARRAY_SIZE(in), &bytes,
+				     K_NO_WAIT), 3, NULL);
+	zassert_equal(bytes, 12, NULL);
+	zassert_equal(k_pipe_put_vec(&vpipe, &in[3], 1, &bytes, K_NO_WAIT),
+		      -EIO, NULL);
+	zassert_equal(bytes, 0, NULL);
+
+	zassert_equal(k_pipe_get_vec(&vpipe, out, ARRAY_SIZE(out), &bytes,
+				     K_NO_WAIT), 2, NULL);
+	zassert_equal(bytes, 12, NULL);
+	zassert_mem_equal(out1, "abcd", 4, NULL);
+	zassert_mem_equal(out2, "efghijkl", 8, NULL);
+
+	/* Only whole segments are read */
+	zassert_equal(k_pipe_put_vec(&vpipe, in, 1, &bytes, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal(k_pipe_get_vec(&vpipe, &out[1], 1, &bytes, K_NO_WAIT),
+		      -EIO, NULL);
+	zassert_equal(k_pipe_get_vec(&vpipe, out, ARRAY_SIZE(out), &bytes,
+				     K_NO_WAIT), 1, NULL);
+	zassert_equal(k_pipe_read_avail(&vpipe), 0, NULL);
+}
+
+/**
+ * @brief Test a vectored write to a blocked reader
+ * @details The reader is handed the first segment and part of the
+ * second, and the rest of the second segment is buffered.
+ * @see k_pipe_put_vec()
+ */
+void test_pipe_vec_reader_wait(void)
+{
+	struct k_pipe_vec in[] = { { seg_a, 4 }, { seg_b, 4 } };
+	unsigned char out[2];
+	size_t bytes;
+
+	k_tid_t tid = k_thread_create(&vdata, vstack, STACK_SIZE,
+				      reader_entry, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	k_msleep(50);
+	zassert_equal(k_pipe_put_vec(&vpipe, in, ARRAY_SIZE(in), &bytes,
+				     K_NO_WAIT), 2, NULL);
+	zassert_equal(bytes, 8, NULL);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(k_pipe_get(&vpipe, out, sizeof(out), &bytes,
+				 sizeof(out), K_NO_WAIT), 0, NULL);
+	zassert_mem_equal(out, "gh", sizeof(out), NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_READY 4
+
+static struct k_sem set_sem;
+static struct k_fifo set_fifo;
+static struct k_poll_signal set_signal;
+static struct k_poll_set set;
+static struct k_poll_event *ready[NUM_READY];
+
+static struct k_thread set_thread;
+K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void init_set(struct k_poll_event *events, int num_events)
+{
+	k_sem_init(&set_sem, 0, 1);
+	k_fifo_init(&set_fifo);
+	k_poll_signal_init(&set_signal);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[2], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	k_poll_set_init(&set);
+	for (int i = 0; i < num_events; i++) {
+		k_poll_set_add(&set, &events[i]);
+	}
+}
+
+/**
+ * @brief Test waiting on a poll set without blocking
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove(),
+ * k_poll_set_wait()
+ */
+void test_poll_set_no_wait(void)
+{
+	struct k_poll_event events[3];
+	void *msg = NULL;
+
+	init_set(events, ARRAY_SIZE(events));
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	/* Only the events which occurred are returned */
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal_ptr(ready[0], &events[0], NULL);
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+	zassert_equal(events[1].state, K_POLL_STATE_NOT_READY, NULL);
+
+	/* An object that is still available is reported again */
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal_ptr(ready[0], &events[0], NULL);
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, NULL);
+
+	k_fifo_put(&set_fifo, &msg);
+	(void)k_poll_signal_raise(&set_signal, 0);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &events[1], NULL);
+	zassert_equal(events[1].state, K_POLL_STATE_FIFO_DATA_AVAILABLE,
+		      NULL);
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT), NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &events[2], NULL);
+	zassert_equal(events[2].state, K_POLL_STATE_SIGNALED, NULL);
+	k_poll_signal_reset(&set_signal);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	/* Removed events are not reported anymore */
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+	k_sem_give(&set_sem);
+	(void)k_poll_signal_raise(&set_signal, 0);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_NO_WAIT),
+		      -EAGAIN, NULL);
+}
+
+static void set_give_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_MSEC(10));
+	k_sem_give(&set_sem);
+}
+
+/**
+ * @brief Test blocking on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_wait(void)
+{
+	struct k_poll_event events[3];
+
+	init_set(events, ARRAY_SIZE(events));
+
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, set_give_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_MSEC(100)),
+		      1, NULL);
+	zassert_equal_ptr(ready[0], &events[0], NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_READY, K_MSEC(10)),
+		      -EAGAIN, NULL);
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+}
@@ -63,6 +63,7 @@ void test_main(void)
 			 ztest_unit_test(test_slice_reset),
 			 ztest_unit_test(test_slice_scheduling),
 			 ztest_unit_test(test_priority_scheduling),
+			 ztest_unit_test(test_priority_scheduling_spread),
 			 ztest_unit_test(test_wakeup_expired_timer_thread),
 			 ztest_user_unit_test(test_user_k_wakeup),
 			 ztest_user_unit_test(test_user_k_is_preempt)
@@ -54,23 +54,15 @@ static void thread_tslice(void *p1, void *p2, void *p3)
 
 }
 
-/* test cases */
-
-/**
- * @brief Check the behavior of preemptive threads with different priorities
- *
- * @details Create multiple threads of different priorities - all are preemptive,
- * current thread is also made preemptive. Check how the threads get chance to
- * execute based on their priorities
- *
- * @ingroup kernel_sched_tests
- */
-void test_priority_scheduling(void)
+/* Runs NUM_THREAD preemptive threads, stride priorities apart */
+static void priority_scheduling(int stride)
 {
 	k_tid_t tid[NUM_THREAD];
 	int old_prio = k_thread_priority_get(k_current_get());
 	int count = 0;
 
+	thread_idx = 0;
+
 	/* update priority for current thread */
 	k_thread_priority_set(k_current_get(),
 			      K_PRIO_PREEMPT(BASE_PRIORITY - 1));
@@ -79,8 +71,8 @@ void test_priority_scheduling(void)
 	for (int i = 0; i < NUM_THREAD; i++) {
 		tid[i] = k_thread_create(&t[i], tstacks[i], STACK_SIZE,
 					 thread_tslice, INT_TO_POINTER(i), NULL, NULL,
-					 K_PRIO_PREEMPT(BASE_PRIORITY + i), 0,
-					 K_NO_WAIT);
+					 K_PRIO_PREEMPT(BASE_PRIORITY + i * stride),
+					 0, K_NO_WAIT);
 	}
 
 	while (count < ITRERATION_COUNT) {
@@ -107,3 +99,34 @@ void test_priority_scheduling(void)
 	/* Set priority of Main thread to its old value */
 	k_thread_priority_set(k_current_get(), old_prio);
 }
+
+/* test cases */
+
+/**
+ * @brief Check the behavior of preemptive threads with different priorities
+ *
+ * @details Create multiple threads of different priorities - all are preemptive,
+ * current thread is also made preemptive. Check how the threads get chance to
+ * execute based on their priorities
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_priority_scheduling(void)
+{
+	priority_scheduling(1);
+}
+
+/**
+ * @brief Check the order of preemptive threads spread over all priorities
+ *
+ * @details Same as test_priority_scheduling(), but with the priorities of
+ * the threads spread over the whole preemptive range, so that ready queues
+ * indexed by priority, like the bitmap one, hold them far apart.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_priority_scheduling_spread(void)
+{
+	priority_scheduling(MAX(1, (K_LOWEST_APPLICATION_THREAD_PRIO -
+				    BASE_PRIORITY) / NUM_THREAD));
+}
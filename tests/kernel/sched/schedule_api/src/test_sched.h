@@ -43,6 +43,7 @@ void test_sched_is_preempt_thread(void);
 void test_slice_reset(void);
 void test_slice_scheduling(void);
 void test_priority_scheduling(void);
+void test_priority_scheduling_spread(void);
 void test_wakeup_expired_timer_thread(void);
 void test_user_k_wakeup(void);
 void test_user_k_is_preempt(void);
@@ -204,12 +204,120 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+static void fill_pattern(uint8_t *p, size_t start, size_t end)
+{
+	for (size_t i = start; i < end; i++) {
+		p[i] = (uint8_t)i;
+	}
+}
+
+static bool check_pattern(uint8_t *p, size_t end)
+{
+	for (size_t i = 0; i < end; i++) {
+		if (p[i] != (uint8_t)i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Resizes a block in the cases sys_heap_realloc() can handle without
+ * copying (shrink, grow into a free right neighbor) and the one where
+ * it has to move the data.
+ */
+static void test_realloc(void)
+{
+	struct sys_heap heap;
+	uint8_t *p, *p2, *blocker;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Grow into the free space to the right */
+	p = sys_heap_alloc(&heap, 64);
+	zassert_not_null(p, "");
+	fill_pattern(p, 0, 64);
+	p2 = sys_heap_realloc(&heap, p, 256);
+	zassert_equal(p, p2, "growing didn't happen in place");
+	zassert_true(check_pattern(p2, 64), "data lost on grow");
+	zassert_true(sys_heap_usable_size(&heap, p2) >= 256, "");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Shrink, then check the tail was freed by growing again */
+	p2 = sys_heap_realloc(&heap, p, 32);
+	zassert_equal(p, p2, "shrinking didn't happen in place");
+	zassert_true(check_pattern(p2, 32), "data lost on shrink");
+	zassert_true(sys_heap_validate(&heap), "");
+	blocker = sys_heap_alloc(&heap, 16);
+	zassert_true(blocker > p && blocker < p + 256,
+		     "shrunk tail wasn't reused");
+
+	/* Now the right neighbor is in use, growing has to move */
+	fill_pattern(p, 0, 32);
+	p2 = sys_heap_realloc(&heap, p, 512);
+	zassert_not_null(p2, "");
+	zassert_not_equal(p, p2, "");
+	zassert_true(check_pattern(p2, 32), "data lost on move");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* A failed realloc leaves the block alone */
+	zassert_is_null(sys_heap_realloc(&heap, p2, SMALL_HEAP_SZ), "");
+	zassert_true(check_pattern(p2, 32), "");
+
+	/* ISO C corner cases */
+	sys_heap_free(&heap, blocker);
+	zassert_is_null(sys_heap_realloc(&heap, p2, 0), "");
+	p = sys_heap_realloc(&heap, NULL, 16);
+	zassert_not_null(p, "");
+	sys_heap_free(&heap, p);
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+/* Grows a buffer in small steps, as an encoder appending to its
+ * output would, while other allocations come and go around it, and
+ * counts how many of the resizes needed a copy.
+ */
+static void test_realloc_growing_buffer(void)
+{
+	struct sys_heap heap;
+	void *others[8] = { NULL };
+	uint8_t *buf = NULL;
+	size_t sz = 0;
+	int copies = 0, steps = 0;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	while (sz + 32 <= SMALL_HEAP_SZ / 2) {
+		uint8_t *p = sys_heap_realloc(&heap, buf, sz + 32);
+
+		zassert_not_null(p, "");
+		zassert_true(check_pattern(p, sz), "data lost on resize");
+		copies += (buf != NULL && p != buf) ? 1 : 0;
+		steps++;
+		buf = p;
+		fill_pattern(buf, sz, sz + 32);
+		sz += 32;
+
+		/* Churn a few small blocks around the buffer */
+		int i = steps % ARRAY_SIZE(others);
+
+		sys_heap_free(&heap, others[i]);
+		others[i] = sys_heap_alloc(&heap, 8 + 8 * i);
+		zassert_true(sys_heap_validate(&heap), "");
+	}
+
+	TC_PRINT("%d of %d resizes of a growing buffer needed a copy\n",
+		 copies, steps);
+	zassert_true(copies < steps / 2, "too many copies");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_realloc),
+			 ztest_unit_test(test_realloc_growing_buffer)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
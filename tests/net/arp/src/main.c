@@ -642,9 +642,113 @@ void test_arp(void)
 	}
 }
 
+/* Feed in an ARP request from the peer, its sender is added to the cache */
+static void arp_learn(struct net_if *iface, struct in_addr *peer,
+		      struct net_eth_addr *peer_hwaddr)
+{
+	struct net_eth_hdr *eth_hdr;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_eth_hdr) +
+					sizeof(struct net_arp_hdr),
+					AF_UNSPEC, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem request");
+
+	setup_eth_header(iface, pkt, net_eth_broadcast_addr(),
+			 NET_ETH_PTYPE_ARP);
+
+	eth_hdr = (struct net_eth_hdr *)net_pkt_data(pkt);
+	net_buf_add(pkt->buffer, sizeof(struct net_eth_hdr));
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+	arp_hdr = NET_ARP_HDR(pkt);
+
+	arp_hdr->hwtype = htons(NET_ARP_HTYPE_ETH);
+	arp_hdr->protocol = htons(NET_ETH_PTYPE_IP);
+	arp_hdr->hwlen = sizeof(struct net_eth_addr);
+	arp_hdr->protolen = sizeof(struct in_addr);
+	arp_hdr->opcode = htons(NET_ARP_REQUEST);
+	memcpy(&arp_hdr->src_hwaddr, peer_hwaddr, sizeof(struct net_eth_addr));
+	(void)memset(&arp_hdr->dst_hwaddr, 0, sizeof(struct net_eth_addr));
+	net_ipaddr_copy(&arp_hdr->src_ipaddr, peer);
+	net_ipaddr_copy(&arp_hdr->dst_ipaddr, if_get_addr(iface));
+
+	net_buf_add(pkt->buffer, sizeof(struct net_arp_hdr));
+
+	zassert_equal(net_arp_input(pkt, eth_hdr), NET_OK,
+		      "ARP request dropped");
+
+	/* Yielding so that network interface TX thread can send the reply */
+	k_yield();
+}
+
+static bool arp_cached(struct in_addr *peer, struct net_eth_addr *peer_hwaddr)
+{
+	entry_found = false;
+	expected_hwaddr = peer_hwaddr;
+	net_arp_foreach(arp_cb, peer);
+
+	return entry_found;
+}
+
+void test_arp_lru(void)
+{
+	struct net_eth_addr hwaddrs[] = {
+		{ { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x21 } },
+		{ { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x22 } },
+		{ { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x23 } },
+	};
+	struct in_addr peers[] = {
+		{ { { 192, 168, 0, 21 } } },
+		{ { { 192, 168, 0, 22 } } },
+		{ { { 192, 168, 0, 23 } } },
+	};
+	struct net_ipv4_hdr *ipv4;
+	struct net_if *iface;
+	struct net_pkt *pkt;
+
+	BUILD_ASSERT(CONFIG_NET_ARP_TABLE_SIZE == 2,
+		     "The test fills a table of two entries");
+
+	iface = net_if_get_default();
+	req_test = true;
+
+	net_arp_clear_cache(iface);
+
+	arp_learn(iface, &peers[0], &hwaddrs[0]);
+	arp_learn(iface, &peers[1], &hwaddrs[1]);
+
+	zassert_true(arp_cached(&peers[0], &hwaddrs[0]), "First not cached");
+	zassert_true(arp_cached(&peers[1], &hwaddrs[1]), "Second not cached");
+
+	/* Using the first entry makes the second one the oldest */
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipaddr_copy(&ipv4->src, if_get_addr(iface));
+	net_ipaddr_copy(&ipv4->dst, &peers[0]);
+
+	zassert_equal_ptr(net_arp_prepare(pkt, &peers[0], NULL), pkt,
+			  "First entry not found");
+	net_pkt_unref(pkt);
+
+	arp_learn(iface, &peers[2], &hwaddrs[2]);
+
+	/**TESTPOINT: Check that the least recently used entry was replaced */
+	zassert_true(arp_cached(&peers[0], &hwaddrs[0]), "First replaced");
+	zassert_false(arp_cached(&peers[1], &hwaddrs[1]), "Second kept");
+	zassert_true(arp_cached(&peers[2], &hwaddrs[2]), "Third not cached");
+
+	net_arp_clear_cache(iface);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_arp_fn,
-		ztest_unit_test(test_arp));
+		ztest_unit_test(test_arp),
+		ztest_unit_test(test_arp_lru));
 	ztest_run_test_suite(test_arp_fn);
 }
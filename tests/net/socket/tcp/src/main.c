@@ -506,6 +506,56 @@ void test_socket_permission(void)
 #endif /* CONFIG_USERSPACE */
 }
 
+void test_v4_recv_zerocopy(void)
+{
+	/* Test if data lent by zsock_recv_zerocopy() is consumed */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct iovec view;
+	struct zsock_zerocopy zc = {
+		.iov = &view,
+		.iovlen = 1,
+	};
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	zassert_equal(zsock_recv_zerocopy(new_sock, &zc, 0),
+		      strlen(TEST_STR_SMALL), "recv failed");
+	zassert_equal(zc.iovlen, 1, "unexpected number of views");
+	zassert_equal(view.iov_len, strlen(TEST_STR_SMALL), "wrong length");
+	zassert_mem_equal(view.iov_base, TEST_STR_SMALL,
+			  strlen(TEST_STR_SMALL), "unexpected data");
+	zsock_recv_zerocopy_release(&zc);
+
+	test_close(c_sock);
+
+	zc.iovlen = 1;
+	zassert_equal(zsock_recv_zerocopy(new_sock, &zc, 0), 0, "no EOF");
+	zassert_equal(zc.iovlen, 0, "views at EOF");
+	zsock_recv_zerocopy_release(&zc);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_main(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -522,6 +572,7 @@ void test_main(void)
 		ztest_user_unit_test(test_v4_sendto_recvfrom_null_dest),
 		ztest_user_unit_test(test_v6_sendto_recvfrom_null_dest),
 		ztest_unit_test(test_open_close_immediately),
+		ztest_unit_test(test_v4_recv_zerocopy),
 		ztest_user_unit_test(test_v4_accept_timeout),
 		ztest_user_unit_test(test_socket_permission)
 		);
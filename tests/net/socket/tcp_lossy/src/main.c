@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <ztest.h>
+#include <net/socket.h>
+#include <net/loopback.h>
+
+/* Goodput of a TCP transfer over a loopback interface dropping a share
+ * of the packets.  Every transfer must complete with intact data.  The
+ * test variants differ in how the receiver handles segments after a loss,
+ * see testcase.yaml.
+ */
+
+#define SERVER_PORT 4242
+#define XFER_SIZE (32 * 1024)
+#define CHUNK_SIZE 512
+#define STACK_SIZE 2048
+
+static const float loss_ratios[] = { 0.0f, 0.01f, 0.02f, 0.05f, 0.10f };
+
+static uint8_t tx_buf[CHUNK_SIZE];
+static uint8_t rx_buf[CHUNK_SIZE];
+
+K_THREAD_STACK_DEFINE(rx_stack, STACK_SIZE);
+static struct k_thread rx_thread;
+
+static volatile size_t rx_total;
+static volatile uint32_t rx_end;
+
+static uint8_t pattern(size_t pos)
+{
+	return (uint8_t)(pos % 251);
+}
+
+static void rx_fn(void *p1, void *p2, void *p3)
+{
+	int s_sock = POINTER_TO_INT(p1);
+	int sock;
+	ssize_t len;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = accept(s_sock, NULL, NULL);
+	zassert_true(sock >= 0, "accept failed (%d)", errno);
+
+	while (rx_total < XFER_SIZE) {
+		len = recv(sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_true(len > 0, "recv failed (%d)", errno);
+
+		for (ssize_t i = 0; i < len; i++) {
+			zassert_equal(rx_buf[i], pattern(rx_total + i),
+				      "data corrupted at %zu", rx_total + i);
+		}
+		rx_total += len;
+	}
+	rx_end = k_uptime_get_32();
+
+	zassert_equal(close(sock), 0, "close failed");
+}
+
+static void transfer(float loss)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint32_t start, dropped, ms;
+	int s_sock, c_sock;
+
+	zassert_equal(inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				&addr.sin_addr), 1, "inet_pton failed");
+
+	s_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(s_sock >= 0, "socket open failed");
+	zassert_equal(bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "bind failed");
+	zassert_equal(listen(s_sock, 1), 0, "listen failed");
+
+	rx_total = 0;
+	k_thread_create(&rx_thread, rx_stack, STACK_SIZE, rx_fn,
+			INT_TO_POINTER(s_sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	c_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(c_sock >= 0, "socket open failed");
+	zassert_equal(connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+
+	/* Only the data transfer is lossy */
+	dropped = loopback_get_num_dropped_packets();
+	zassert_equal(loopback_set_packet_drop_ratio(loss), 0, NULL);
+	start = k_uptime_get_32();
+
+	for (size_t pos = 0; pos < XFER_SIZE; pos += CHUNK_SIZE) {
+		for (size_t i = 0; i < CHUNK_SIZE; i++) {
+			tx_buf[i] = pattern(pos + i);
+		}
+		zassert_equal(send(c_sock, tx_buf, CHUNK_SIZE, 0), CHUNK_SIZE,
+			      "send failed (%d)", errno);
+	}
+
+	zassert_equal(k_thread_join(&rx_thread, K_SECONDS(120)), 0,
+		      "transfer did not complete, got %zu bytes", rx_total);
+	zassert_equal(loopback_set_packet_drop_ratio(0.0f), 0, NULL);
+
+	ms = MAX(rx_end - start, 1U);
+	dropped = loopback_get_num_dropped_packets() - dropped;
+	TC_PRINT("loss %3u%% goodput %7u bytes/s (%u packets dropped)\n",
+		 (unsigned int)(loss * 100.0f + 0.5f),
+		 (uint32_t)((uint64_t)XFER_SIZE * MSEC_PER_SEC / ms), dropped);
+
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+
+	/* Let the connection go away before the next one */
+	k_sleep(K_SECONDS(1));
+}
+
+void test_tcp_lossy_goodput(void)
+{
+	TC_PRINT("out-of-order queue %u bytes, SACK %s\n",
+		 CONFIG_NET_TCP_OUT_OF_ORDER_QUEUE_SIZE,
+		 IS_ENABLED(CONFIG_NET_TCP_SACK) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(loss_ratios); i++) {
+		transfer(loss_ratios[i]);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_tcp_lossy,
+			 ztest_unit_test(test_tcp_lossy_goodput));
+	ztest_run_test_suite(socket_tcp_lossy);
+}
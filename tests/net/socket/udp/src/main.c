@@ -954,6 +954,222 @@ void test_v6_sendmsg_with_txtime(void)
 	test_started = false;
 }
 
+void test_v4_recvmsg_pktinfo(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	int on = 1;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	struct in_pktinfo *info;
+	struct msghdr msg;
+	struct cmsghdr *cmsg;
+	struct iovec io_vector[2];
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in_pktinfo))];
+	} cmsgbuf;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(server_sock, IPPROTO_IP, IP_PKTINFO, &on, sizeof(on));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* The datagram is scattered over two buffers and truncated */
+	clear_buf(rx_buf);
+	io_vector[0].iov_base = rx_buf;
+	io_vector[0].iov_len = 16;
+	io_vector[1].iov_base = rx_buf + 16;
+	io_vector[1].iov_len = 16;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_name = &addr;
+	msg.msg_namelen = sizeof(addr);
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, 32, "recvmsg failed (%d)", errno);
+	zassert_mem_equal(rx_buf, TEST_STR2, 32, "wrong data");
+	zassert_equal(msg.msg_flags, MSG_TRUNC, "datagram not truncated");
+	zassert_equal(msg.msg_namelen, sizeof(addr), "unexpected addrlen");
+	zassert_equal(addr.sin_family, AF_INET, "unexpected family");
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no ancillary data");
+	zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "unexpected level");
+	zassert_equal(cmsg->cmsg_type, IP_PKTINFO, "unexpected type");
+
+	info = (struct in_pktinfo *)CMSG_DATA(cmsg);
+	zassert_true(net_ipv4_addr_cmp(&info->ipi_addr,
+				       &server_addr.sin_addr),
+		     "unexpected destination address");
+	zassert_true(info->ipi_ifindex > 0, "no interface");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 4
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec io_vector[MMSG_COUNT];
+	int i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	/* Datagrams of growing size */
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = TEST_STR2;
+		io_vector[i].iov_len = i + 1;
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, i + 1, "unexpected sent bytes");
+	}
+
+	clear_buf(rx_buf);
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = rx_buf + i * 8;
+		io_vector[i].iov_len = 8;
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the queued datagrams are returned */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, i + 1,
+			      "unexpected received bytes");
+		zassert_mem_equal(rx_buf + i * 8, TEST_STR2, i + 1,
+				  "wrong data");
+	}
+
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg did not fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno %d", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recv_zerocopy(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct iovec views[8];
+	struct zsock_zerocopy zc;
+	size_t len = 0;
+	size_t i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* The datagram spans several buffers, each one gets a view */
+	zc.iov = views;
+	zc.iovlen = ARRAY_SIZE(views);
+	rv = zsock_recv_zerocopy(server_sock, &zc, 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recv failed (%d)", errno);
+	zassert_true(zc.iovlen > 1, "datagram in a single view");
+
+	for (i = 0; i < zc.iovlen; i++) {
+		zassert_mem_equal(views[i].iov_base, TEST_STR2 + len,
+				  views[i].iov_len, "wrong data");
+		len += views[i].iov_len;
+	}
+
+	zassert_equal(len, STRLEN(TEST_STR2), "views do not add up");
+	zsock_recv_zerocopy_release(&zc);
+	zassert_is_null(zc.pkt, "buffers not released");
+
+	/* What does not fit into the views is discarded */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	zc.iovlen = 1;
+	rv = zsock_recv_zerocopy(server_sock, &zc, 0);
+	zassert_true(rv > 0 && rv < STRLEN(TEST_STR2), "recv failed (%d)",
+		     errno);
+	zassert_equal(zc.iovlen, 1, "unexpected number of views");
+	zassert_mem_equal(views[0].iov_base, TEST_STR2, rv, "wrong data");
+	zsock_recv_zerocopy_release(&zc);
+
+	zc.iovlen = ARRAY_SIZE(views);
+	rv = zsock_recv_zerocopy(server_sock, &zc, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv did not fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno %d", errno);
+
+	rv = zsock_recv_zerocopy(server_sock, &zc, MSG_PEEK);
+	zassert_equal(rv, -1, "recv did not fail");
+	zassert_equal(errno, EINVAL, "unexpected errno %d", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -976,6 +1192,11 @@ void test_main(void)
 			 ztest_user_unit_test(test_v4_sendmsg_recvfrom_connected),
 			 ztest_unit_test(test_v6_sendmsg_recvfrom_connected),
 			 ztest_user_unit_test(test_v6_sendmsg_recvfrom_connected),
+			 ztest_unit_test(test_v4_recvmsg_pktinfo),
+			 ztest_user_unit_test(test_v4_recvmsg_pktinfo),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v4_recv_zerocopy),
 			 ztest_unit_test(test_setup_eth),
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime)
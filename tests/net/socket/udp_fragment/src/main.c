@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <ztest.h>
+#include <net/socket.h>
+
+/* UDP datagrams larger than the MTU of the loopback interface.  They are
+ * sent to the peer address, so that they go through the loopback driver
+ * which returns them to us, and they are fragmented on the way out and
+ * reassembled on the way in.
+ */
+
+#define SERVER_PORT 4242
+#define MAX_SIZE (8 * 1024)
+
+static const size_t sizes[] = { 600, 1500, 4096, MAX_SIZE };
+
+static uint8_t tx_buf[MAX_SIZE];
+static uint8_t rx_buf[MAX_SIZE + 1];
+
+static int s_sock, c_sock;
+
+static void setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	zassert_equal(inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				&addr.sin_addr), 1, "inet_pton failed");
+
+	s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(s_sock >= 0, "socket open failed");
+	zassert_equal(bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "bind failed");
+
+	zassert_equal(inet_pton(AF_INET, CONFIG_NET_CONFIG_PEER_IPV4_ADDR,
+				&addr.sin_addr), 1, "inet_pton failed");
+
+	c_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(c_sock >= 0, "socket open failed");
+	zassert_equal(connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+}
+
+static void transfer(size_t size, uint8_t seed)
+{
+	ssize_t len;
+
+	for (size_t i = 0; i < size; i++) {
+		tx_buf[i] = (uint8_t)(i * 7 + seed);
+	}
+
+	zassert_equal(send(c_sock, tx_buf, size, 0), size,
+		      "send failed (%d)", errno);
+
+	len = recv(s_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(len, size, "recv failed (%d), got %zd bytes", errno,
+		      len);
+	zassert_mem_equal(rx_buf, tx_buf, size, "data corrupted, size %zu",
+			  size);
+}
+
+void test_udp_fragment_sizes(void)
+{
+	setup();
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		transfer(sizes[i], i);
+	}
+}
+
+void test_udp_fragment_repeat(void)
+{
+	/* Every datagram uses a reassembly slot, which must be released */
+	for (int i = 0; i < 2 * CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT + 2; i++) {
+		transfer(MAX_SIZE, i);
+	}
+
+	zassert_equal(close(c_sock), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_udp_fragment,
+			 ztest_unit_test(test_udp_fragment_sizes),
+			 ztest_unit_test(test_udp_fragment_repeat));
+	ztest_run_test_suite(socket_udp_fragment);
+}
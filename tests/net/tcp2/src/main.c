@@ -346,6 +346,47 @@ fail:
 	return -EINVAL;
 }
 
+/* Whether the segment carries the SACK permitted option */
+static bool sack_perm_found(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[40];
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	bool found = false;
+	size_t i = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (len > sizeof(opts) ||
+	    net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, opts, len) < 0) {
+		zassert_true(false, "Failed to read TCP options");
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	while (i < len && opts[i] != TCPOPT_END) {
+		if (opts[i] == TCPOPT_NOP) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= len || opts[i + 1] < 2U) {
+			break;
+		}
+
+		if (opts[i] == TCPOPT_SACK_PERM) {
+			found = true;
+		}
+
+		i += opts[i + 1];
+	}
+
+	return found;
+}
+
 static int tester_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct tcphdr th;
@@ -361,8 +402,18 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 2:
 		handle_client_test(net_pkt_family(pkt), &th);
 		break;
-	case 3:
 	case 4:
+		/* The peer offered SACK, it is only agreed to when there is
+		 * an out-of-order queue to report on.
+		 */
+		if (th.th_flags & SYN) {
+			zassert_equal(sack_perm_found(pkt, &th),
+				      IS_ENABLED(CONFIG_NET_TCP_SACK),
+				      "SACK permitted option mismatch");
+		}
+		handle_server_test(net_pkt_family(pkt), &th);
+		break;
+	case 3:
 	case 5:
 		handle_server_test(net_pkt_family(pkt), &th);
 		break;
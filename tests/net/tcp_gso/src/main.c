@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+/* Software TCP segmentation of the Ethernet layer: a packet carrying
+ * several segments worth of data is sent through a driver without
+ * ETHERNET_HW_TSO, which must see proper, separate frames.
+ */
+
+#define MSS 1000
+#define SEQ 0x12345678
+#define MAX_FRAMES 4
+#define MAX_FRAME_LEN (sizeof(struct net_eth_hdr) + NET_IPV6H_LEN + \
+		       NET_TCPH_LEN + MSS)
+#define WAIT_TIME K_SECONDS(1)
+
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 2 } } };
+
+static uint8_t peer_mac[6] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+static uint8_t data[3 * MSS];
+
+struct eth_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_ctx = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+};
+
+/* The frames seen by the driver, flattened */
+static uint8_t frames[MAX_FRAMES][MAX_FRAME_LEN];
+static size_t frame_len[MAX_FRAMES];
+static int frame_count;
+
+static K_SEM_DEFINE(frame_sent, 0, MAX_FRAMES);
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct eth_context *ctx = net_if_get_device(iface)->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+/* No offload at all, the Ethernet layer splits the packet and the IP
+ * layer computes the checksums of every segment.
+ */
+static enum ethernet_hw_caps eth_caps(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static int eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+
+	ARG_UNUSED(dev);
+
+	if (frame_count == MAX_FRAMES || len > MAX_FRAME_LEN) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, frames[frame_count], len)) {
+		return -ENOBUFS;
+	}
+
+	frame_len[frame_count++] = len;
+	k_sem_give(&frame_sent);
+
+	return 0;
+}
+
+static int eth_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+	.get_capabilities = eth_caps,
+	.send = eth_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_gso, "eth_gso", eth_init, device_pm_control_nop,
+		    &eth_ctx, NULL, CONFIG_ETH_INIT_PRIORITY, &eth_api,
+		    NET_ETH_MTU);
+
+static uint32_t chksum_add(uint32_t sum, const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += (buf[i] << 8) | buf[i + 1];
+	}
+
+	if (len & 1) {
+		sum += buf[len - 1] << 8;
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return (uint16_t)~sum;
+}
+
+static void test_setup(void)
+{
+	struct net_linkaddr lladdr = {
+		.addr = peer_mac,
+		.len = sizeof(peer_mac),
+		.type = NET_LINK_ETHERNET,
+	};
+	struct net_if_addr *ifaddr;
+
+	zassert_not_null(eth_ctx.iface, "no interface");
+
+	ifaddr = net_if_ipv6_addr_add(eth_ctx.iface, &my_addr6,
+				      NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "cannot add IPv6 address");
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+
+	ifaddr = net_if_ipv4_addr_add(eth_ctx.iface, &my_addr4,
+				      NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "cannot add IPv4 address");
+
+	/* Neighbor discovery is off, the peer is known statically */
+	zassert_not_null(net_ipv6_nbr_add(eth_ctx.iface, &peer_addr6, &lladdr,
+					  false, NET_IPV6_NBR_STATE_STATIC),
+			 "cannot add neighbor");
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7;
+	}
+}
+
+static void send_gso(sa_family_t family, size_t len, uint8_t flags)
+{
+	struct net_tcp_hdr hdr = {
+		.src_port = htons(4242),
+		.dst_port = htons(4243),
+		.offset = (NET_TCPH_LEN / 4) << 4,
+		.flags = flags,
+		.wnd = { 0x10, 0x00 },
+	};
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(eth_ctx.iface, NET_TCPH_LEN + len,
+					family, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "cannot allocate packet");
+
+	if (family == AF_INET6) {
+		ret = net_ipv6_create(pkt, &my_addr6, &peer_addr6);
+	} else {
+		ret = net_ipv4_create(pkt, &my_addr4, &peer_addr4);
+	}
+	zassert_equal(ret, 0, "cannot create IP header");
+
+	sys_put_be32(SEQ, hdr.seq);
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "cannot write TCP header");
+	zassert_equal(net_pkt_write(pkt, data, len), 0, "cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	if (family == AF_INET6) {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	}
+	zassert_equal(ret, 0, "cannot finalize packet");
+
+	net_pkt_set_gso_size(pkt, MSS);
+
+	frame_count = 0;
+	k_sem_reset(&frame_sent);
+
+	if (net_send_data(pkt) < 0) {
+		net_pkt_unref(pkt);
+		zassert_true(false, "send failed");
+	}
+}
+
+/* Checks the frame of segment i of a packet of len bytes of data */
+static void check_segment(sa_family_t family, int i, size_t len,
+			  uint8_t flags, const uint8_t *dst_mac)
+{
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)frames[i];
+	uint8_t *ip = frames[i] + sizeof(*eth);
+	size_t pos = i * MSS, seg_len = MIN(MSS, len - pos);
+	size_t ip_hdr_len, tcp_len = NET_TCPH_LEN + seg_len;
+	struct net_tcp_hdr *tcp;
+	uint8_t pseudo[4];
+	uint32_t sum;
+
+	zassert_mem_equal(eth->src.addr, eth_ctx.mac_addr, 6,
+			  "segment %d: wrong source MAC", i);
+	zassert_mem_equal(eth->dst.addr, dst_mac, 6,
+			  "segment %d: wrong destination MAC", i);
+
+	if (family == AF_INET6) {
+		struct net_ipv6_hdr *ip6 = (struct net_ipv6_hdr *)ip;
+
+		ip_hdr_len = NET_IPV6H_LEN;
+		zassert_equal(eth->type, htons(NET_ETH_PTYPE_IPV6),
+			      "segment %d: wrong type", i);
+		zassert_equal(ntohs(ip6->len), tcp_len,
+			      "segment %d: wrong payload length", i);
+
+		sum = chksum_add(0, (uint8_t *)&ip6->src,
+				 2 * sizeof(struct in6_addr));
+	} else {
+		struct net_ipv4_hdr *ip4 = (struct net_ipv4_hdr *)ip;
+
+		ip_hdr_len = NET_IPV4H_LEN;
+		zassert_equal(eth->type, htons(NET_ETH_PTYPE_IP),
+			      "segment %d: wrong type", i);
+		zassert_equal(ntohs(ip4->len),
+			      ip_hdr_len + tcp_len,
+			      "segment %d: wrong total length", i);
+		zassert_equal(chksum_fold(chksum_add(0, ip, ip_hdr_len)), 0,
+			      "segment %d: wrong IPv4 checksum", i);
+
+		sum = chksum_add(0, (uint8_t *)&ip4->src,
+				 2 * sizeof(struct in_addr));
+	}
+
+	zassert_equal(frame_len[i], sizeof(*eth) + ip_hdr_len + tcp_len,
+		      "segment %d: wrong frame length", i);
+
+	tcp = (struct net_tcp_hdr *)(ip + ip_hdr_len);
+	zassert_equal(sys_get_be32(tcp->seq), SEQ + pos,
+		      "segment %d: wrong sequence number", i);
+
+	/* Only the last segment pushes or finishes */
+	if (pos + seg_len < len) {
+		flags &= ~(NET_TCP_PSH | NET_TCP_FIN);
+	}
+	zassert_equal(tcp->flags, flags, "segment %d: wrong flags", i);
+
+	zassert_mem_equal(tcp->optdata, data + pos, seg_len,
+			  "segment %d: wrong data", i);
+
+	sys_put_be16(IPPROTO_TCP, pseudo);
+	sys_put_be16(tcp_len, pseudo + 2);
+	sum = chksum_add(sum, pseudo, sizeof(pseudo));
+	sum = chksum_add(sum, (uint8_t *)tcp, tcp_len);
+	zassert_equal(chksum_fold(sum), 0, "segment %d: wrong TCP checksum",
+		      i);
+}
+
+static void check_gso(sa_family_t family, size_t len, uint8_t flags,
+		      const uint8_t *dst_mac)
+{
+	int count = (len + MSS - 1) / MSS;
+
+	send_gso(family, len, flags);
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&frame_sent, WAIT_TIME), 0,
+			      "segment %d not sent", i);
+	}
+
+	zassert_equal(k_sem_take(&frame_sent, K_MSEC(100)), -EAGAIN,
+		      "too many segments");
+	zassert_equal(frame_count, count, "wrong number of segments");
+
+	for (int i = 0; i < count; i++) {
+		check_segment(family, i, len, flags, dst_mac);
+	}
+}
+
+/* The last segment is shorter, the destination is the neighbor */
+static void test_gso_ipv6(void)
+{
+	check_gso(AF_INET6, 2 * MSS + MSS / 2, NET_TCP_ACK | NET_TCP_PSH,
+		  peer_mac);
+}
+
+/* Without ARP the destination is the broadcast address */
+static void test_gso_ipv4(void)
+{
+	static const uint8_t broadcast[6] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+	};
+
+	check_gso(AF_INET, 3 * MSS, NET_TCP_ACK | NET_TCP_PSH | NET_TCP_FIN,
+		  broadcast);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_gso,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_gso_ipv6),
+			 ztest_unit_test(test_gso_ipv4));
+
+	ztest_run_test_suite(net_tcp_gso);
+}
@@ -714,6 +714,57 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+/*
+ * Test that the history of an id is found when other ids are written in
+ * between. With a small lookup cache these ids share cache positions.
+ */
+void test_nvs_read_hist(void)
+{
+	int err;
+	ssize_t len;
+	uint16_t id, data, data_read;
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (data = 0; data < 3; data++) {
+		for (id = 0; id < 10; id++) {
+			len = nvs_write(&fs, id, &data, sizeof(data));
+			zassert_true(len == sizeof(data),
+				     "nvs_write failed: %d", len);
+		}
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (id = 0; id < 10; id++) {
+			for (uint16_t cnt = 0; cnt < 3; cnt++) {
+				len = nvs_read_hist(&fs, id, &data_read,
+						    sizeof(data_read), cnt);
+				zassert_true(len == sizeof(data_read),
+					     "nvs_read_hist failed: %d", len);
+				zassert_equal(data_read, 2 - cnt,
+					      "unexpected history data");
+			}
+
+			len = nvs_read_hist(&fs, id, &data_read,
+					    sizeof(data_read), 3);
+			zassert_true(len == -ENOENT,
+				     "nvs_read_hist found too old data: %d",
+				     len);
+		}
+
+		len = nvs_read(&fs, 10, &data_read, sizeof(data_read));
+		zassert_true(len == -ENOENT,
+			     "nvs_read found unwritten id: %d", len);
+
+		/* same again from the allocation table entries in flash */
+		err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+		zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -737,7 +788,9 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_read_hist, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
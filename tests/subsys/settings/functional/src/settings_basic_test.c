@@ -23,6 +23,12 @@ LOG_MODULE_REGISTER(settings_basic_test);
 #include <fs/fs.h>
 #include <fs/littlefs.h>
 #endif
+#if IS_ENABLED(CONFIG_SETTINGS_BATCH)
+#include "settings_priv.h"
+#endif
+#if IS_ENABLED(CONFIG_STATS)
+#include <stats/stats.h>
+#endif
 
 /* The standard test expects a cleared flash area.  Make sure it has
  * one.
@@ -606,6 +612,234 @@ static void test_direct_loading_filter(void)
 	}
 }
 
+#if IS_ENABLED(CONFIG_SETTINGS_BATCH)
+#define BATCH_KEYS 4
+
+/* Value of batch/<n>, 0 if it is not stored */
+static uint8_t batch_vals[BATCH_KEYS];
+
+static int batch_loader(const char *key, size_t len, settings_read_cb read_cb,
+			void *cb_arg, void *param)
+{
+	unsigned int *count = param;
+	int n;
+
+	(*count)++;
+
+	/* The journal itself, without a name below it */
+	if (!key) {
+		return 0;
+	}
+
+	n = key[0] - '0';
+	zassert_true(n >= 0 && n < BATCH_KEYS, "unexpected key %s", key);
+	zassert_equal(len, 1, "unexpected value length");
+
+	return (read_cb(cb_arg, &batch_vals[n], 1) == 1) ? 0 : -EIO;
+}
+
+static void batch_load(void)
+{
+	unsigned int count = 0;
+	int rc;
+
+	memset(batch_vals, 0, sizeof(batch_vals));
+	rc = settings_load_subtree_direct("batch", batch_loader, &count);
+	zassert_equal(rc, 0, "loading failed");
+
+	count = 0;
+	rc = settings_load_subtree_direct(SETTINGS_BATCH_NAME, batch_loader,
+					  &count);
+	zassert_equal(rc, 0, "loading failed");
+	zassert_equal(count, 0, "journal left behind");
+}
+
+static void batch_save(uint8_t base)
+{
+	char name[] = "batch/0";
+	uint8_t val;
+	int rc;
+
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		name[6] = '0' + n;
+		val = base + n;
+		rc = settings_save_one(name, &val, sizeof(val));
+		zassert_equal(rc, 0, "save failed");
+	}
+}
+
+#if IS_ENABLED(CONFIG_STATS)
+static int flash_write_calls_find(struct stats_hdr *hdr, void *arg,
+				  const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_write_calls")) {
+		*(uint32_t **)arg = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+#endif
+
+/* Number of flash writes so far, 0 without the flash simulator */
+static uint32_t flash_writes(void)
+{
+	uint32_t *calls = NULL;
+
+#if IS_ENABLED(CONFIG_STATS)
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	if (hdr) {
+		stats_walk(hdr, flash_write_calls_find, &calls);
+	}
+#endif
+
+	return calls ? *calls : 0U;
+}
+
+static void batch_journal_add(uint8_t *buf, size_t *len, const char *name,
+			      const void *value, size_t val_len)
+{
+	struct settings_batch_rec rec = {
+		.name_len = strlen(name),
+		.val_len = val_len,
+	};
+
+	memcpy(buf + *len, &rec, sizeof(rec));
+	*len += sizeof(rec);
+	memcpy(buf + *len, name, rec.name_len);
+	*len += rec.name_len;
+	memcpy(buf + *len, value, val_len);
+	*len += val_len;
+}
+
+static void test_batch(void)
+{
+	uint32_t single_writes, batch_writes, journal_writes;
+	uint8_t journal[64], val;
+	char name[] = "batch/0";
+	size_t len = 0;
+	int rc;
+
+	/* Create the keys first, so that both ways below only store new
+	 * values of existing keys.
+	 */
+	batch_save(0);
+
+	/* Every value saved twice, one by one */
+	single_writes = flash_writes();
+	batch_save(10);
+	batch_save(20);
+	single_writes = flash_writes() - single_writes;
+
+	batch_load();
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		zassert_equal(batch_vals[n], 20 + n, "wrong value");
+	}
+
+	/* The same in a batch, only the last values are written */
+	rc = settings_batch_begin();
+	zassert_equal(rc, 0, "batch begin failed");
+	zassert_equal(settings_batch_begin(), -EBUSY, "nested batch");
+
+	batch_writes = flash_writes();
+	batch_save(30);
+	batch_save(40);
+	zassert_equal(flash_writes(), batch_writes, "batch written early");
+
+	rc = settings_batch_commit();
+	zassert_equal(rc, 0, "batch commit failed");
+	batch_writes = flash_writes() - batch_writes;
+
+	batch_load();
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		zassert_equal(batch_vals[n], 40 + n, "wrong value");
+	}
+
+	printk("flash writes: %u one by one, %u in a batch\n", single_writes,
+	       batch_writes);
+	if (single_writes && (IS_ENABLED(CONFIG_SETTINGS_FCB) ||
+			      IS_ENABLED(CONFIG_SETTINGS_NVS))) {
+		zassert_true(batch_writes < single_writes,
+			     "batch did not save flash writes");
+	}
+
+	/* Every value saved once, one by one and in a batch. Nothing is
+	 * coalesced, so the batch writes the same entries plus its journal.
+	 */
+	single_writes = flash_writes();
+	batch_save(50);
+	single_writes = flash_writes() - single_writes;
+
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		name[6] = '0' + n;
+		val = 60 + n;
+		batch_journal_add(journal, &len, name, &val, sizeof(val));
+	}
+
+	journal_writes = flash_writes();
+	rc = settings_save_one(SETTINGS_BATCH_NAME, journal, len);
+	zassert_equal(rc, 0, "journal save failed");
+	rc = settings_delete(SETTINGS_BATCH_NAME);
+	zassert_equal(rc, 0, "journal delete failed");
+	journal_writes = flash_writes() - journal_writes;
+	len = 0;
+
+	rc = settings_batch_begin();
+	zassert_equal(rc, 0, "batch begin failed");
+	batch_writes = flash_writes();
+	batch_save(60);
+	rc = settings_batch_commit();
+	zassert_equal(rc, 0, "batch commit failed");
+	batch_writes = flash_writes() - batch_writes;
+
+	batch_load();
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		zassert_equal(batch_vals[n], 60 + n, "wrong value");
+	}
+
+	printk("flash writes of distinct keys: %u one by one, %u in a batch "
+	       "(journal %u)\n", single_writes, batch_writes, journal_writes);
+	if (single_writes && (IS_ENABLED(CONFIG_SETTINGS_FCB) ||
+			      IS_ENABLED(CONFIG_SETTINGS_NVS))) {
+		zassert_true(batch_writes > single_writes,
+			     "batch journal not written");
+		zassert_true(batch_writes <= single_writes + journal_writes,
+			     "batch wrote more than its journal");
+	}
+
+	/* An aborted batch leaves the storage alone */
+	rc = settings_batch_begin();
+	zassert_equal(rc, 0, "batch begin failed");
+	batch_save(70);
+	settings_batch_abort();
+	zassert_equal(settings_batch_commit(), -EINVAL, "commit after abort");
+
+	batch_load();
+	for (int n = 0; n < BATCH_KEYS; n++) {
+		zassert_equal(batch_vals[n], 60 + n, "wrong value");
+	}
+
+	/* A journal left by a commit interrupted by a reset is applied */
+	val = 80;
+	batch_journal_add(journal, &len, "batch/0", &val, sizeof(val));
+	batch_journal_add(journal, &len, "batch/1", NULL, 0);
+	rc = settings_save_one(SETTINGS_BATCH_NAME, journal, len);
+	zassert_equal(rc, 0, "journal save failed");
+
+	rc = settings_batch_recover();
+	zassert_equal(rc, 0, "batch recovery failed");
+
+	batch_load();
+	zassert_equal(batch_vals[0], 80, "journal not applied");
+	zassert_equal(batch_vals[1], 0, "journal delete not applied");
+	zassert_equal(batch_vals[2], 62, "wrong value");
+}
+#else
+static void test_batch(void)
+{
+	ztest_test_skip();
+}
+#endif
 
 void test_main(void)
 {
@@ -614,7 +848,8 @@ void test_main(void)
 			 ztest_unit_test(test_support_rtn),
 			 ztest_unit_test(test_register_and_loading),
 			 ztest_unit_test(test_direct_loading),
-			 ztest_unit_test(test_direct_loading_filter)
+			 ztest_unit_test(test_direct_loading_filter),
+			 ztest_unit_test(test_batch)
 			);
 
 	ztest_run_test_suite(settings_test_suite);